@@ -0,0 +1,117 @@
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QString>
+#include <QtLogging>
+
+#include "../src/MpscRingBuffer.h"
+
+namespace {
+    using Message = std::pair<QtMsgType, QString>;
+
+    class LockedLog {
+    public:
+        bool push(Message&& msg) {
+            const std::lock_guard<std::mutex> locker(_mutex);
+            _log.emplace_back(std::move(msg));
+            return true;
+        }
+
+        bool pop(Message& msg) {
+            const std::lock_guard<std::mutex> locker(_mutex);
+            if (_log.empty())
+                return false;
+
+            msg = std::move(_log.front());
+            _log.pop_front();
+            return true;
+        }
+
+    private:
+        std::mutex _mutex;
+        std::deque<Message> _log;
+    };
+
+    class RingLog {
+    public:
+        explicit RingLog(size_t capacity) : _ring(capacity) {}
+
+        bool push(Message&& msg) { return _ring.try_push(std::move(msg)); }
+        bool pop(Message& msg) { return _ring.try_pop(msg); }
+
+    private:
+        MpscRingBuffer<Message> _ring;
+    };
+
+    struct Result {
+        double time;
+        size_t collected;
+        size_t dropped;
+    };
+
+    template <typename Log>
+    Result run(Log& log, int producer_count, int message_count) {
+        std::atomic<int> finished_count = 0;
+        std::atomic<size_t> dropped = 0;
+        std::vector<std::thread> producers;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < producer_count; ++i) {
+            producers.emplace_back([&log, &finished_count, &dropped, message_count, i]() {
+                const QString text = QStringLiteral("A message from the producer %1: ").arg(i);
+                size_t local_dropped = 0;
+                for (int j = 0; j < message_count; ++j) {
+                    if (!log.push(std::make_pair(QtDebugMsg, text + QString::number(j))))
+                        ++local_dropped;
+                }
+                dropped.fetch_add(local_dropped, std::memory_order::relaxed);
+                finished_count.fetch_add(1, std::memory_order::release);
+            });
+        }
+        size_t collected = 0;
+        Message msg;
+        while (true) { // note: The consumer drains the log continuously, like the main thread does with a timer
+            const bool finished = finished_count.load(std::memory_order::acquire) == producer_count;
+            while (log.pop(msg))
+                ++collected;
+
+            if (finished)
+                break;
+
+            std::this_thread::yield();
+        }
+        const double time = timer.nsecsElapsed() / 1e6;
+        for (std::thread& producer : producers)
+            producer.join();
+
+        return {time, collected, dropped.load()};
+    }
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    const int max_producer_count = argc > 1 ? QString(argv[1]).toInt() : std::max(int(std::thread::hardware_concurrency()), 2);
+    const int message_count = argc > 2 ? QString(argv[2]).toInt() : 200'000;
+    std::printf("%d messages per producer, the ring buffer has 8192 slots\n", message_count);
+    std::printf("%10s %12s %12s %12s %12s\n", "producers", "mutex ms", "ring ms", "ring drops", "ring ns/msg");
+    for (int producer_count = 1; producer_count <= max_producer_count; producer_count *= 2) {
+        LockedLog locked_log;
+        const Result locked = run(locked_log, producer_count, message_count);
+        RingLog ring_log(8192);
+        const Result ring = run(ring_log, producer_count, message_count);
+        if (locked.collected != size_t(producer_count) * message_count || ring.collected + ring.dropped != size_t(producer_count) * message_count) {
+            std::fprintf(stderr, "Messages were lost\n");
+            return 1;
+        }
+        std::printf("%10d %12.1f %12.1f %12zu %12.1f\n", producer_count, locked.time, ring.time, ring.dropped, ring.time * 1e6 / (size_t(producer_count) * message_count));
+    }
+
+    return 0;
+}
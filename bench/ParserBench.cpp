@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <random>
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QTimeZone>
+#include <QUrl>
+
+#include "../src/FileSystem/FileSystemObject.h"
+#include "../src/FileSystem/Parser/Parser.h"
+#include "../src/FileSystem/Parser/TimeParser.h"
+#include "../src/Logger.h"
+#include "../src/Util.h"
+#include "../tests/AllocationCounter.h"
+
+namespace {
+    enum class Style {Apache, Nginx, Iis, Nextcloud, SabreDav};
+
+    struct Corpus {
+        const char* style_name;
+        QString current_path;
+        QByteArray data;
+        size_t response_count;
+    };
+
+    const char* get_style_name(Style style) {
+        switch (style) {
+            case Style::Apache: return "apache";
+            case Style::Nginx: return "nginx";
+            case Style::Iis: return "iis";
+            case Style::Nextcloud: return "nextcloud";
+            case Style::SabreDav: return "sabredav";
+        }
+        return "";
+    }
+
+    class CorpusGenerator {
+    public:
+        explicit CorpusGenerator(Style style) : _style(style), _generator(2212) {
+            const QDateTime epoch(QDate(2015, 1, 1), QTime(0, 0), QTimeZone::UTC);
+            for (size_t i = 0; i < _dates.size(); ++i) { // note: A small pool of dates is formatted once, so the generation doesn't dominate the run time
+                const QDateTime time = epoch.addSecs(_generator() % (10 * 365 * 24 * 3600));
+                _dates[i] = {time.toString(QStringLiteral("ddd, dd MMM yyyy hh:mm:ss 'GMT'")).toLatin1(),
+                             time.toString(_style == Style::Iis ? QStringLiteral("yyyy-MM-dd'T'hh:mm:ss.zzz'Z'") : QStringLiteral("yyyy-MM-dd'T'hh:mm:ss'Z'")).toLatin1()};
+            }
+        }
+
+        Corpus generate(size_t response_count) {
+            Corpus corpus{get_style_name(_style), get_current_path(), {}, response_count};
+            corpus.data.reserve(response_count * 640);
+            corpus.data += get_header();
+            append_response(corpus.data, QByteArray(), true);
+            for (size_t i = 1; i < response_count; ++i) {
+                const bool is_dir = _generator() % 8 == 0;
+                append_response(corpus.data, get_name(i, is_dir), is_dir);
+            }
+            corpus.data += get_footer();
+            return corpus;
+        }
+
+    private:
+        QString get_current_path() const {
+            switch (_style) {
+                case Style::Nextcloud: return QStringLiteral("/remote.php/dav/files/user/Documents/");
+                case Style::SabreDav: return QStringLiteral("/server.php/files/");
+                default: return QStringLiteral("/dav/");
+            }
+        }
+
+        QByteArray get_header() const {
+            QByteArray header = "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n";
+            switch (_style) {
+                case Style::Apache: return header + "<D:multistatus xmlns:D=\"DAV:\" xmlns:ns0=\"DAV:\">\n";
+                case Style::Nginx: return header + "<D:multistatus xmlns:D=\"DAV:\">\n";
+                case Style::Iis: return "<?xml version=\"1.0\"?><a:multistatus xmlns:b=\"urn:uuid:c2f41010-65b3-11d1-a29f-00aa00c14882/\" xmlns:a=\"DAV:\">"; // note: IIS writes the whole reply in one line
+                case Style::Nextcloud: return header + "<d:multistatus xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\" xmlns:oc=\"http://owncloud.org/ns\" xmlns:nc=\"http://nextcloud.org/ns\">";
+                case Style::SabreDav: return header + "<d:multistatus xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\">";
+            }
+            return header;
+        }
+
+        QByteArray get_footer() const {
+            switch (_style) {
+                case Style::Apache:
+                case Style::Nginx: return "</D:multistatus>\n";
+                case Style::Iis: return "</a:multistatus>";
+                default: return "</d:multistatus>\n";
+            }
+        }
+
+        QByteArray get_name(size_t index, bool is_dir) {
+            constexpr std::array<const char*, 8> words{"Report", "photo", "IMG", "backup", "Invoice", "draft", "Отчёт", "scan"};
+            constexpr std::array<const char*, 6> extensions{".pdf", ".jpg", ".txt", ".odt", ".zip", ".tar.gz"};
+            QByteArray name = QByteArray(words[_generator() % words.size()]) + (_generator() % 4 == 0 ? " " : "_") + QByteArray::number(index);
+            if (!is_dir)
+                name += extensions[_generator() % extensions.size()];
+
+            return QUrl::toPercentEncoding(QString::fromUtf8(name));
+        }
+
+        void append_response(QByteArray& data, const QByteArray& name, bool is_dir) {
+            const QByteArray path = get_current_path().toUtf8() + name + (is_dir && !name.isEmpty() ? "/" : "");
+            const auto& [last_modified, creation_date] = _dates[_generator() % _dates.size()];
+            const QByteArray size = QByteArray::number(_generator() % 100'000'000);
+            switch (_style) {
+                case Style::Apache:
+                    data += "<D:response xmlns:lp1=\"DAV:\" xmlns:lp2=\"http://apache.org/dav/props/\" xmlns:g0=\"DAV:\">\n<D:href>" + path + "</D:href>\n<D:propstat>\n<D:prop>\n";
+                    data += is_dir ? "<lp1:resourcetype><D:collection/></lp1:resourcetype>\n" : "<lp1:resourcetype/>\n<lp1:getcontentlength>" + size + "</lp1:getcontentlength>\n";
+                    data += "<lp1:creationdate>" + creation_date + "</lp1:creationdate>\n<lp1:getlastmodified>" + last_modified + "</lp1:getlastmodified>\n";
+                    data += "<lp2:executable>F</lp2:executable>\n</D:prop>\n<D:status>HTTP/1.1 200 OK</D:status>\n</D:propstat>\n";
+                    if (is_dir)
+                        data += "<D:propstat>\n<D:prop>\n<g0:getcontentlength/>\n</D:prop>\n<D:status>HTTP/1.1 404 Not Found</D:status>\n</D:propstat>\n";
+
+                    data += "</D:response>\n";
+                    break;
+
+                case Style::Nginx:
+                    data += "<D:response>\n<D:href>" + path + "</D:href>\n<D:propstat>\n<D:prop>\n<D:getlastmodified>" + last_modified + "</D:getlastmodified>\n";
+                    data += is_dir ? "<D:resourcetype><D:collection/></D:resourcetype>\n" : "<D:resourcetype></D:resourcetype>\n<D:getcontentlength>" + size + "</D:getcontentlength>\n";
+                    data += "</D:prop>\n<D:status>HTTP/1.1 200 OK</D:status>\n</D:propstat>\n";
+                    data += "<D:propstat>\n<D:prop>\n<D:creationdate/>\n</D:prop>\n<D:status>HTTP/1.1 404 Not Found</D:status>\n</D:propstat>\n</D:response>\n";
+                    break;
+
+                case Style::Iis:
+                    data += "<a:response><a:href>" + path + "</a:href><a:propstat><a:status>HTTP/1.1 200 OK</a:status><a:prop>";
+                    data += "<a:getcontentlength b:dt=\"int\">" + (is_dir ? QByteArray("0") : size) + "</a:getcontentlength>";
+                    data += "<a:creationdate b:dt=\"dateTime.tz\">" + creation_date + "</a:creationdate>";
+                    data += "<a:getlastmodified b:dt=\"dateTime.rfc1123\">" + last_modified + "</a:getlastmodified>";
+                    data += is_dir ? "<a:resourcetype><a:collection/></a:resourcetype>" : "<a:resourcetype/>";
+                    data += "</a:prop></a:propstat></a:response>";
+                    break;
+
+                case Style::Nextcloud:
+                case Style::SabreDav:
+                    data += "<d:response><d:href>" + path + "</d:href><d:propstat><d:prop><d:getlastmodified>" + last_modified + "</d:getlastmodified>";
+                    data += is_dir ? "<d:resourcetype><d:collection/></d:resourcetype>" : "<d:getcontentlength>" + size + "</d:getcontentlength><d:resourcetype/>";
+                    if (_style == Style::Nextcloud)
+                        data += "<oc:fileid>" + QByteArray::number(_generator() % 10'000'000) + "</oc:fileid><oc:permissions>RGDNVW</oc:permissions><nc:has-preview>false</nc:has-preview>";
+
+                    data += "</d:prop><d:status>HTTP/1.1 200 OK</d:status></d:propstat><d:propstat><d:prop><d:creationdate/>";
+                    if (is_dir)
+                        data += "<d:getcontentlength/>";
+
+                    data += "</d:prop><d:status>HTTP/1.1 404 Not Found</d:status></d:propstat></d:response>\n";
+                    break;
+            }
+        }
+
+    private:
+        const Style _style;
+        std::mt19937 _generator;
+        std::array<std::pair<QByteArray, QByteArray>, 256> _dates; // note: The pairs of getlastmodified and creationdate
+    };
+
+    QJsonObject measure_parse(const Corpus& corpus) {
+        const int run_count = corpus.response_count <= 1000 ? 100 : corpus.response_count <= 100'000 ? 5 : 1;
+        double best_time = std::numeric_limits<double>::max();
+        uint64_t allocations = 0;
+        uint64_t allocated_bytes = 0;
+        int64_t peak_heap = 0;
+        for (int run = 0; run < run_count; ++run) {
+            const AllocationCounter counter;
+            QElapsedTimer timer;
+            timer.start();
+            Parser::Result result = Parser::parse_propfind_reply(corpus.current_path, corpus.data);
+            const double time = timer.nsecsElapsed() / 1e9;
+            if (!result.first || result.second.size() + 1 != corpus.response_count) {
+                QTextStream(stderr) << "The " << corpus.style_name << " corpus of " << corpus.response_count << " responses is parsed into " << result.second.size() << " objects\n";
+                std::exit(1);
+            }
+            best_time = std::min(best_time, time);
+            allocations = counter.get_count(); // note: The same on every run, so the last one is reported
+            allocated_bytes = counter.get_size();
+            peak_heap = counter.get_peak_size();
+        }
+        const double mib = corpus.data.size() / (1024.0 * 1024.0);
+        QJsonObject obj;
+        obj["style"] = corpus.style_name;
+        obj["responses"] = static_cast<qint64>(corpus.response_count);
+        obj["bytes"] = static_cast<qint64>(corpus.data.size());
+        obj["runs"] = run_count;
+        obj["best_ms"] = best_time * 1e3;
+        obj["mib_per_s"] = mib / best_time;
+        obj["responses_per_s"] = corpus.response_count / best_time;
+        obj["allocations_per_response"] = static_cast<double>(allocations) / corpus.response_count;
+        obj["allocated_bytes_per_response"] = static_cast<double>(allocated_bytes) / corpus.response_count;
+        obj["peak_heap_kib"] = static_cast<qint64>(peak_heap / 1024); // note: Includes the parsed objects, which are alive until the result is destroyed
+        return obj;
+    }
+
+    QJsonObject measure_time_parser(const char* form, const QString& str, Parser::CurrentState::TimeParser::Format format, int64_t expected) {
+        using TimeParser = Parser::CurrentState::TimeParser;
+
+        constexpr int call_count = 1'000'000;
+        const AllocationCounter counter;
+        QElapsedTimer timer;
+        timer.start();
+        int64_t checksum = 0;
+        for (int i = 0; i < call_count; ++i)
+            checksum += TimeParser::to_sys_seconds(str, format).time_since_epoch().count();
+
+        const double time = timer.nsecsElapsed();
+        const uint64_t allocations = counter.get_count();
+        if (checksum != expected * call_count) { // note: The checksum keeps the calls from being optimised away too
+            QTextStream(stderr) << "The " << form << " date \"" << str << "\" is parsed incorrectly\n";
+            std::exit(1);
+        }
+        QJsonObject obj;
+        obj["form"] = form;
+        obj["input"] = str;
+        obj["ns_per_call"] = time / call_count;
+        obj["allocations_per_call"] = static_cast<double>(allocations) / call_count;
+        return obj;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    Logger::get_instance()->set_max_level(QtWarningMsg); // note: The debug level would store the whole reply text in the log on every parse
+    const size_t max_count = argc > 1 ? QString(argv[1]).toULongLong() : 1'000'000;
+
+    QJsonArray parse_results;
+    for (const Style style : {Style::Apache, Style::Nginx, Style::Iis, Style::Nextcloud, Style::SabreDav}) {
+        CorpusGenerator generator(style);
+        for (const size_t count : {size_t(1000), size_t(100'000), size_t(1'000'000)}) {
+            if (count > max_count)
+                break;
+
+            parse_results.append(measure_parse(generator.generate(count)));
+        }
+    }
+
+    using Format = Parser::CurrentState::TimeParser::Format;
+    constexpr int64_t rfc2616_seconds = 784111777; // note: 1994-11-06 08:49:37 UTC
+    QJsonArray time_results;
+    time_results.append(measure_time_parser("rfc1123", QStringLiteral("Sun, 06 Nov 1994 08:49:37 GMT"), Format::Rfc2616, rfc2616_seconds));
+    time_results.append(measure_time_parser("rfc850", QStringLiteral("Sunday, 06-Nov-94 08:49:37 GMT"), Format::Rfc2616, rfc2616_seconds));
+    time_results.append(measure_time_parser("asctime", QStringLiteral("Sun Nov 6 08:49:37 1994"), Format::Rfc2616, rfc2616_seconds));
+    time_results.append(measure_time_parser("rfc3339_utc", QStringLiteral("1994-11-06T08:49:37Z"), Format::Rfc3339, rfc2616_seconds));
+    time_results.append(measure_time_parser("rfc3339_fraction", QStringLiteral("1994-11-06T08:49:37.473Z"), Format::Rfc3339, rfc2616_seconds));
+    time_results.append(measure_time_parser("rfc3339_offset", QStringLiteral("1994-11-06T10:19:37+01:30"), Format::Rfc3339, rfc2616_seconds));
+
+    QJsonObject root;
+    root["parse"] = parse_results;
+    root["time_parser"] = time_results;
+    root["peak_rss_kib"] = static_cast<qint64>(get_peak_rss_kib());
+    QTextStream(stdout) << QJsonDocument(root).toJson();
+    return 0;
+}
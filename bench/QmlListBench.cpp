@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+#include <QAbstractItemModel>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QQmlContext>
+#include <QQmlError>
+#include <QQuickItem>
+#include <QQuickView>
+#include <QQuickWindow>
+#include <QSet>
+#include <QStandardPaths>
+#include <QTextStream>
+#include <QUrl>
+
+#include "../src/App.h"
+#include "../src/Logger.h"
+#include "../src/Metrics.h"
+#include "../src/Qml/FileSystemModel.h"
+#include "../src/Qml/ItemModelManager.h"
+#include "../src/Qml/Sort/SortKeys.h"
+#include "../src/Util.h"
+#include "../tests/AllocationCounter.h"
+#include "../tests/MockDavServer/MockDavServer.h"
+
+namespace {
+    constexpr int view_width = 480;
+    constexpr int view_height = 800;
+    constexpr int flick_frame_count = 600;
+    constexpr double flick_velocity = 4000; // note: In pixels per second, a fast fling on a phone
+    constexpr double frame_interval = 1.0 / 60; // note: In seconds
+    constexpr int timeout = 600'000; // note: In milliseconds; serving and parsing the listing of 1M files takes a while
+
+    // note: Counts the delegates of a list view, which have been created since the construction. The items are checked after every frame,
+    //       so the counting doesn't add to the measured frame time. The destroyed delegates are forgotten, so a new delegate at the same address is counted.
+    class DelegateCounter {
+    public:
+        explicit DelegateCounter(QQuickItem* content_item) : _content_item(content_item) { update(); }
+
+        DelegateCounter(const DelegateCounter&) = delete;
+        DelegateCounter& operator=(const DelegateCounter&) = delete;
+
+        void update() {
+            for (QQuickItem* item : _content_item->childItems()) {
+                if (_live_items.contains(item) || !item->property("index").isValid())
+                    continue; // note: The highlight and the border of the list view aren't delegates
+
+                _live_items.insert(item);
+                ++_created_count;
+                QObject::connect(item, &QObject::destroyed, &_receiver, [this, item]() { _live_items.remove(item); });
+            }
+            _max_live_count = std::max(_max_live_count, to_type<uint64_t>(_live_items.size()));
+        }
+
+        void reset_max_live_count() noexcept { _max_live_count = _live_items.size(); }
+        uint64_t get_created_count() const noexcept { return _created_count; }
+        uint64_t get_max_live_count() const noexcept { return _max_live_count; }
+
+    private:
+        QQuickItem* const _content_item;
+        QSet<const QQuickItem*> _live_items;
+        uint64_t _created_count = 0;
+        uint64_t _max_live_count = 0;
+        QObject _receiver; // note: The last member, so the connections are broken before the set is destroyed
+    };
+
+    double to_ms(int64_t nsecs) { return nsecs / 1e6; }
+
+    bool wait_for(const std::function<bool ()>& predicate) { // note: The log timer of the application wakes the loop up regularly, so the timeout is checked even without other events
+        QElapsedTimer timer;
+        timer.start();
+        while (!predicate() && timer.elapsed() < timeout)
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+
+        return predicate();
+    }
+
+    int64_t render_frame(QQuickView& view) { // note: In the basic render loop of the software backend the grab polishes, synchronizes and renders the scene at once
+        QElapsedTimer timer;
+        timer.start();
+        view.grabWindow();
+        return timer.nsecsElapsed();
+    }
+
+    QQuickItem* find_file_list_view(QQuickItem* root) {
+        for (QQuickItem* item : root->findChildren<QQuickItem*>()) {
+            if (item->inherits("QQuickListView") && item->isVisible()) // note: The list of the search results is hidden, until the whole tree search is checked
+                return item;
+        }
+        return nullptr;
+    }
+
+    std::optional<QJsonObject> measure(QQuickView& view, QQuickItem& list_view, Qml::FileSystemModel& fs_model, int row_count) {
+        MockDavServer::Config config;
+        config.depth = 0;
+        config.file_count = row_count;
+        MockDavServer server(config);
+        if (!server.listen()) {
+            qCritical("The mock server can't listen");
+            return std::nullopt;
+        }
+
+        std::optional<AllocationCounter> counter;
+        QElapsedTimer clock;
+        int64_t reply_time = -1;
+        int64_t model_time = -1;
+        int64_t sorted_time = -1;
+        bool failed = false;
+        QObject receiver;
+        QObject::connect(&fs_model, &Qml::FileSystemModel::errorOccurred, &receiver, [&failed](const QString& text) { qCritical("%s", qUtf8Printable(text)); failed = true; });
+        QObject::connect(&fs_model, &Qml::FileSystemModel::replyGot, &receiver, [&]() { reply_time = clock.nsecsElapsed(); counter.emplace(); }); // note: Precedes the connection of prepare(), so the model creation is counted
+        QMetaObject::invokeMethod(view.rootObject(), "prepare");
+        const auto handle_model = [&]() {
+            model_time = clock.nsecsElapsed();
+            if (row_count < Qml::SortKeys::parallel_threshold)
+                return;
+
+            const auto model = list_view.property("model").value<QAbstractItemModel*>(); // note: The sorted order is installed later with a layout change
+            QObject::connect(model, &QAbstractItemModel::layoutChanged, &receiver, [&sorted_time, &clock]() { if (sorted_time < 0) sorted_time = clock.nsecsElapsed(); });
+        };
+        QObject::connect(&fs_model, &Qml::FileSystemModel::replyGot, &receiver, handle_model);
+        clock.start();
+        fs_model.setServerInfo(QStringLiteral("127.0.0.1"), server.get_port());
+        fs_model.setRootPath(QStringLiteral("/dav/"));
+        fs_model.requestAbsoluteFileList(QStringLiteral("/dav/"));
+        if (!wait_for([&]() { return model_time >= 0 || failed; }) || failed) {
+            qCritical("The listing of %d files hasn't been got", row_count);
+            return std::nullopt;
+        }
+
+        DelegateCounter delegates(list_view.property("contentItem").value<QQuickItem*>());
+        const int64_t first_frame_time = render_frame(view);
+        const int64_t first_frame_end = clock.nsecsElapsed();
+        delegates.update();
+        QJsonObject obj;
+        obj["rows"] = row_count;
+        obj["request_ms"] = to_ms(reply_time);
+        obj["model_ms"] = to_ms(model_time - reply_time);
+        obj["first_frame_ms"] = to_ms(first_frame_time);
+        obj["time_to_first_frame_ms"] = to_ms(first_frame_end - reply_time);
+        obj["first_frame_delegates"] = static_cast<qint64>(delegates.get_created_count());
+        if (row_count >= Qml::SortKeys::parallel_threshold) {
+            if (!wait_for([&sorted_time]() { return sorted_time >= 0; })) {
+                qCritical("The sorted order of %d files hasn't been installed", row_count);
+                return std::nullopt;
+            }
+            obj["sorted_ms"] = to_ms(sorted_time - reply_time);
+            obj["sorted_frame_ms"] = to_ms(render_frame(view));
+            delegates.update();
+        }
+        obj["model_peak_heap_kib"] = static_cast<qint64>(counter->get_peak_size() / 1024); // note: The sort runs on the pool threads, so its allocations are missing
+
+        counter.emplace();
+        const uint64_t created_count = delegates.get_created_count();
+        delegates.reset_max_live_count();
+        Metrics::Histogram frame_times;
+        qreal y = list_view.property("contentY").toReal();
+        qreal direction = 1;
+        for (int frame = 0; frame < flick_frame_count; ++frame) {
+            const qreal top = list_view.property("originY").toReal() - list_view.property("topMargin").toReal();
+            const qreal bottom = std::max(top, top + list_view.property("contentHeight").toReal() + list_view.property("topMargin").toReal() + list_view.property("bottomMargin").toReal() - list_view.height()); // note: The content height of a list view is estimated, so it's read on every frame
+            y += direction * flick_velocity * frame_interval;
+            if (y >= bottom) {
+                y = bottom;
+                direction = -1;
+            } else if (y <= top) {
+                y = top;
+                direction = 1;
+            }
+            list_view.setProperty("contentY", y);
+            frame_times.record(render_frame(view) / 1000);
+            QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete); // note: The delegates, which have left the view, are destroyed between the frames as in the event loop
+            delegates.update();
+        }
+        const Metrics::Histogram::Summary summary = frame_times.get_summary();
+        QJsonObject frame_obj;
+        frame_obj["count"] = static_cast<qint64>(summary.count);
+        frame_obj["mean"] = static_cast<qint64>(summary.mean);
+        frame_obj["p50"] = static_cast<qint64>(summary.p50);
+        frame_obj["p90"] = static_cast<qint64>(summary.p90);
+        frame_obj["p99"] = static_cast<qint64>(summary.p99);
+        frame_obj["max"] = static_cast<qint64>(summary.max);
+        obj["flick_frame_us"] = frame_obj;
+        obj["flick_delegates_created"] = static_cast<qint64>(delegates.get_created_count() - created_count);
+        obj["flick_max_live_delegates"] = static_cast<qint64>(delegates.get_max_live_count());
+        obj["flick_allocations_per_frame"] = static_cast<double>(counter->get_count()) / flick_frame_count; // note: Including the grabbed image of every frame
+        obj["flick_peak_heap_kib"] = static_cast<qint64>(counter->get_peak_size() / 1024);
+        obj["peak_rss_kib"] = static_cast<qint64>(get_peak_rss_kib()); // note: The row counts grow, so the peak belongs to the current count; the serving and the parsing of the reply are included
+        counter.reset();
+
+        QMetaObject::invokeMethod(&list_view, "destroyModel");
+        fs_model.disconnect();
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+        return obj;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    if (!qEnvironmentVariableIsSet("QT_QUICK_BACKEND"))
+        QQuickWindow::setGraphicsApi(QSGRendererInterface::Software); // note: Renders on the GUI thread without a GPU, so a frame can be rendered on demand and timed
+
+    QStandardPaths::setTestModeEnabled(true); // note: The settings and the search index of the user stay untouched
+    App app(argc, argv);
+    Logger::get_instance()->set_max_level(QtWarningMsg);
+    const int max_count = argc > 1 ? QString(argv[1]).toInt() : 1'000'000;
+
+    QQmlApplicationEngine engine;
+    app.initialize_engine(engine);
+    qmlRegisterUncreatableMetaObject(Qml::ItemModel::staticMetaObject, "WebDavClient", 1, 0, "ItemModel", QStringLiteral("Only the enumeration is accessible")); // note: The page is loaded from the sources, so the plugin of the QML module isn't imported
+    QQuickView view(&engine, nullptr);
+    view.setResizeMode(QQuickView::SizeRootObjectToView);
+    view.resize(view_width, view_height);
+    view.setSource(QUrl::fromLocalFile(QStringLiteral(QML_DIR "/FileListPageColumnLayout.qml")));
+    if (view.status() != QQuickView::Ready) {
+        for (const QQmlError& error : view.errors())
+            QTextStream(stderr) << error.toString() << '\n';
+
+        return 1;
+    }
+    view.show();
+    render_frame(view); // note: The scene graph is initialized by the first frame, so it isn't measured
+
+    QQuickItem* const list_view = find_file_list_view(view.rootObject());
+    auto fs_model = qobject_cast<Qml::FileSystemModel*>(engine.rootContext()->contextProperty("fileSystemModel").value<QObject*>());
+    if (list_view == nullptr || fs_model == nullptr) {
+        qCritical("The file list view or the file system model isn't found");
+        return 1;
+    }
+
+    QJsonArray results;
+    for (const int row_count : {1'000, 100'000, 1'000'000}) {
+        if (row_count > max_count)
+            break;
+
+        const std::optional<QJsonObject> result = measure(view, *list_view, *fs_model, row_count);
+        if (!result)
+            return 1;
+
+        results.append(*result);
+    }
+    QDir(get_config_path() + QStringLiteral("/index")).removeRecursively();
+
+    QJsonObject root;
+    root["platform"] = QGuiApplication::platformName();
+    root["width"] = view_width;
+    root["height"] = view_height;
+    root["results"] = results;
+    QTextStream(stdout) << QJsonDocument(root).toJson();
+    return 0;
+}
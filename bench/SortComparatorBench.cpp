@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QString>
+#include <QThreadPool>
+
+#include "../src/FileSystem/FileSystemObject.h"
+#include "../src/Qml/FileItemModel/Role.h"
+#include "../src/Qml/Sort/SortKeys.h"
+#include "../src/Qml/Sort/SortParam.h"
+#include "../tests/SortKeysReference.h"
+
+using Qml::SortKeys;
+using Qml::SortParam;
+using Role = Qml::FileItemModelRole;
+
+namespace {
+    SortKeys generate_keys(size_t count, bool natural = false) {
+        using Status = FileSystemObject::Status;
+
+        const std::array<QString, 8> words{"Report", "photo", "IMG", "backup", "Invoice", "draft", "Отчёт", "scan"};
+        const std::array<QString, 6> extensions{".pdf", ".jpg", ".txt", ".odt", ".zip", ""};
+        std::mt19937 generator(2212);
+        SortKeys keys(natural);
+        keys.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            const auto is_dir = generator() % 8 == 0;
+            QString name = words[generator() % words.size()] + '_' + QString::number(generator() % 100000);
+            if (!is_dir)
+                name += extensions[generator() % extensions.size()];
+
+            const auto to_time = [&generator]() { return std::make_pair(generator() % 16 == 0 ? Status::None : Status::Ok, std::chrono::sys_seconds(std::chrono::seconds(1'600'000'000 + generator() % 100'000'000))); };
+            std::pair<Status, uint64_t> size{is_dir ? Status::None : Status::Ok, generator() % 10'000'000};
+            keys.append(FileSystemObject(std::move(name), is_dir ? FileSystemObject::Type::Directory : FileSystemObject::Type::File, to_time(), to_time(), std::move(size)));
+        }
+        return keys;
+    }
+
+    std::vector<SortParam> to_params(std::initializer_list<std::pair<Role, bool>> list) {
+        std::vector<SortParam> params;
+        for (const auto& pair : list)
+            params.push_back(SortParam{pair.first, QString(), pair.second});
+
+        return params;
+    }
+
+    QString to_string(const std::vector<SortParam>& params) {
+        QString str;
+        for (const SortParam& param : params) {
+            switch (param.role) {
+                case Role::FileFlag: str += "type"; break;
+                case Role::Name: str += "name"; break;
+                case Role::Extension: str += "ext"; break;
+                case Role::CreationTime: str += "ctime"; break;
+                case Role::ModTime: str += "mtime"; break;
+                case Role::Size: str += "size"; break;
+                default: break;
+            }
+            str += param.descending ? "- " : "+ ";
+        }
+        return str.trimmed();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    const size_t count = argc > 1 ? QString(argv[1]).toULongLong() : 1'000'000;
+    const SortKeys keys = generate_keys(count);
+    const std::vector<std::vector<SortParam>> param_lists{
+        to_params({{Role::Name, false}, {Role::ModTime, false}, {Role::Size, false}}),
+        to_params({{Role::ModTime, true}, {Role::Name, false}}),
+        to_params({{Role::Size, false}, {Role::Extension, false}, {Role::Name, false}}),
+        to_params({{Role::Extension, false}, {Role::Name, true}}),
+        to_params({{Role::FileFlag, false}, {Role::Name, false}, {Role::ModTime, false}, {Role::CreationTime, false}, {Role::Size, false}, {Role::Extension, false}})
+    };
+    std::printf("%zu rows, a comparison cost is the sort time divided by the comparison count of the generic sort\n", count);
+    QThreadPool pool;
+    std::printf("%-44s %12s %12s %12s %12s %12s %12s\n", "parameters", "comparisons", "generic ms", "generic ns", "special ms", "special ns", "parallel ms");
+    for (const std::vector<SortParam>& params : param_lists) {
+        size_t comparisons = 0;
+        std::vector<int> order(count);
+        std::iota(std::begin(order), std::end(order), 0);
+        QElapsedTimer timer;
+        timer.start();
+        std::stable_sort(std::begin(order), std::end(order), [&keys, &params, &comparisons](int left, int right) {
+            ++comparisons;
+            return SortKeysReference::compare(keys, params, left, right) < 0;
+        });
+        const double generic_time = timer.nsecsElapsed() / 1e6;
+
+        timer.restart();
+        const std::vector<int> ranks = SortKeysReference::get_ranks(keys, params);
+        const double special_time = timer.nsecsElapsed() / 1e6;
+
+        timer.restart();
+        const std::vector<int> parallel_ranks = SortKeysReference::get_ranks(keys, params, &pool);
+        const double parallel_time = timer.nsecsElapsed() / 1e6;
+        for (size_t i = 0; i < count; ++i) {
+            if (ranks[order[i]] != int(i) || parallel_ranks[order[i]] != int(i)) {
+                std::fprintf(stderr, "The orders differ for the parameters \"%s\"\n", qUtf8Printable(to_string(params)));
+                return 1;
+            }
+        }
+        std::printf("%-44s %12zu %12.1f %12.2f %12.1f %12.2f %12.1f\n", qUtf8Printable(to_string(params)), comparisons, generic_time, generic_time * 1e6 / comparisons, special_time, special_time * 1e6 / comparisons, parallel_time);
+    }
+
+    const SortKeys natural_keys = generate_keys(count, true);
+    const std::vector<SortParam> name_params = to_params({{Role::Name, false}});
+    QElapsedTimer timer;
+    timer.start();
+    keys.get_order(name_params);
+    const double plain_time = timer.nsecsElapsed() / 1e6;
+
+    timer.restart();
+    natural_keys.get_order(name_params);
+    const double natural_time = timer.nsecsElapsed() / 1e6;
+    std::printf("name+ plain %.1f ms, natural %.1f ms\n", plain_time, natural_time);
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <QAbstractListModel>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QString>
+#include <QStringList>
+
+#include "../src/Qml/Sort/SubstringMatcher.h"
+
+using Qml::SubstringMatcher;
+
+namespace {
+    class NameModel : public QAbstractListModel {
+    public:
+        explicit NameModel(const std::vector<QString>& names) : _names(names) {}
+
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override { return parent.isValid() ? 0 : _names.size(); }
+        QVariant data(const QModelIndex& index, int role) const override { return role == Qt::DisplayRole ? QVariant(_names[index.row()]) : QVariant(); }
+
+    private:
+        const std::vector<QString>& _names;
+    };
+
+    std::vector<QString> generate_names(size_t count) {
+        const std::array<QString, 16> words{"Report", "photo", "IMG", "backup", "Invoice", "draft", "Отчёт", "final", "scan", "Video", "notes", "archive", "Budget", "copy", "Документ", "export"};
+        const std::array<QString, 8> extensions{".pdf", ".jpg", ".txt", ".odt", ".zip", ".mp4", ".xlsx", ""};
+        std::mt19937 generator(2212);
+        std::vector<QString> names;
+        names.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            QString name;
+            const int word_count = 1 + generator() % 4;
+            for (int j = 0; j < word_count; ++j) {
+                name += words[generator() % words.size()];
+                name += j % 2 == 0 ? '_' : ' ';
+            }
+            name += QString::number(generator() % 100000);
+            name += extensions[generator() % extensions.size()];
+            names.push_back(std::move(name));
+        }
+        return names;
+    }
+
+    double measure(const std::function<size_t ()>& func, size_t& match_count) {
+        constexpr int run_count = 5;
+        std::array<double, run_count> times;
+        for (double& time : times) {
+            QElapsedTimer timer;
+            timer.start();
+            match_count = func();
+            time = timer.nsecsElapsed() / 1e6;
+        }
+        std::sort(std::begin(times), std::end(times));
+        return times[run_count / 2];
+    }
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    const size_t count = argc > 1 ? QString(argv[1]).toULongLong() : 1'000'000;
+    const std::vector<QString> names = generate_names(count);
+    std::vector<QString> folded_names;
+    folded_names.reserve(count);
+    SubstringMatcher::Pool pool;
+    pool.reserve(count, std::accumulate(std::begin(names), std::end(names), size_t(0), [](size_t sum, const QString& name) { return sum + name.size(); }));
+    for (const QString& name : names) {
+        folded_names.push_back(name.toCaseFolded());
+        pool.append(folded_names.back());
+    }
+    pool.finish();
+    const NameModel model(names);
+
+    std::printf("%zu names, median of 5 runs, ms\n", count);
+    std::printf("%-12s %10s %10s %10s %10s %10s %8s\n", "query", "data()", "indexOf", "folded", "matcher", "narrow", "matches");
+    for (const QString query : {"e", "ph", "IMG", "отч", "backup_", "invoice 4", "zzz", "final_copy_9"}) {
+        size_t model_matches, index_of_matches, folded_matches, matcher_matches, narrow_matches;
+        const double model_time = measure([&]() {
+            size_t matches = 0;
+            for (int row = 0, rows = model.rowCount(); row < rows; ++row)
+                matches += model.index(row).data(Qt::DisplayRole).toString().indexOf(query, 0, Qt::CaseInsensitive) != -1;
+
+            return matches;
+        }, model_matches);
+        const double index_of_time = measure([&]() {
+            return size_t(std::count_if(std::begin(names), std::end(names), [&query](const QString& name) { return name.indexOf(query, 0, Qt::CaseInsensitive) != -1; }));
+        }, index_of_matches);
+        const QString folded_query = query.toCaseFolded();
+        const double folded_time = measure([&]() {
+            return size_t(std::count_if(std::begin(folded_names), std::end(folded_names), [&folded_query](const QString& name) { return name.contains(folded_query); }));
+        }, folded_matches);
+        const SubstringMatcher matcher(folded_query);
+        std::vector<int> rows;
+        const double matcher_time = measure([&]() {
+            matcher.find_all(pool, rows);
+            return rows.size();
+        }, matcher_matches);
+        const double narrow_time = measure([&]() {
+            rows.resize(count);
+            std::iota(std::begin(rows), std::end(rows), 0);
+            matcher.narrow(pool, rows);
+            return rows.size();
+        }, narrow_matches);
+        if (model_matches != index_of_matches || index_of_matches != folded_matches || folded_matches != matcher_matches || matcher_matches != narrow_matches) {
+            std::fprintf(stderr, "The match counts differ for the query \"%s\"\n", qUtf8Printable(query));
+            return 1;
+        }
+        std::printf("%-12s %10.2f %10.2f %10.2f %10.2f %10.2f %8zu\n", qUtf8Printable(query), model_time, index_of_time, folded_time, matcher_time, narrow_time, matcher_matches);
+    }
+    return 0;
+}
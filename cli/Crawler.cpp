@@ -0,0 +1,54 @@
+#include "Crawler.h"
+
+#include "../src/FileSystem/FileSystemObject.h"
+#include "../src/Util.h"
+
+Crawler::Crawler(const QUrl& url, int max_depth, size_t max_count) : _url(url), _max_depth(max_depth), _max_count(max_count), _model(std::make_unique<FileSystemModel>()) {
+    _model->add_notification_func(this, std::bind(&Crawler::handle_reply, this));
+    _model->set_error_func(std::bind(&Crawler::handle_error, this, std::placeholders::_1, std::placeholders::_2));
+}
+
+Crawler::~Crawler() {
+    _model->remove_notification_func(this);
+    _model->set_error_func(nullptr);
+}
+
+void Crawler::start(FinishFunc&& finish_func) {
+    _finish_func = std::move(finish_func);
+    _model->set_server_info(_url.host(), _url.port(80));
+    _model->set_root_path(_url.path().isEmpty() ? QStringLiteral("/") : _url.path());
+    _queue.push_back(Dir{_model->get_current_path(), 0});
+    request_next();
+}
+
+const std::vector<Crawler::Listing>& Crawler::get_listings() const noexcept { return _listings; }
+
+void Crawler::request_next() {
+    if (_queue.empty() || _listings.size() == _max_count) {
+        _model->disconnect();
+        _finish_func();
+        return;
+    }
+    _current = std::move(_queue.front());
+    _queue.pop_front();
+    _model->request_abs_file_list(_current.path);
+}
+
+void Crawler::handle_reply() {
+    const size_t size = _model->size();
+    _listings.push_back(Listing{_current.path, _current.depth, size, _model->get_request_timing(), QString()});
+    if (_max_depth < 0 || _current.depth < _max_depth) {
+        for (size_t i = 0; i < size; ++i) {
+            const FileSystemObject obj = _model->get_object(i);
+            if (obj.get_type() == FileSystemObject::Type::Directory)
+                _queue.push_back(Dir{_current.path + obj.get_name() + '/', _current.depth + 1});
+        }
+    }
+    QMetaObject::invokeMethod(QCoreApplication::instance(), [this]() { request_next(); }, Qt::QueuedConnection); // note: The next request must not replace the reply, whose handler is being executed
+}
+
+void Crawler::handle_error(FileSystemModel::Error error, QNetworkReply::NetworkError network_error) {
+    const QString text = error == FileSystemModel::Error::ReplyParseError ? QObject::tr("Reply parse error") : QObject::tr("Network error %1").arg(to_int(network_error));
+    _listings.push_back(Listing{_current.path, _current.depth, 0, RequestTiming(), text});
+    QMetaObject::invokeMethod(QCoreApplication::instance(), [this]() { request_next(); }, Qt::QueuedConnection);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <QNetworkReply>
+#include <QString>
+#include <QUrl>
+
+#include "../src/FileSystem/FileSystemModel.h"
+#include "../src/FileSystem/RequestTiming.h"
+
+// note: It requests the listings one by one in the breadth-first order through the same file system model, which the application uses
+class Crawler {
+public:
+    struct Listing {
+        QString path;
+        int depth;
+        size_t entry_count;
+        RequestTiming timing;
+        QString error;
+    };
+
+    using FinishFunc = std::function<void ()>;
+
+    Crawler(const QUrl& url, int max_depth, size_t max_count);
+    ~Crawler();
+
+    void start(FinishFunc&& finish_func);
+    const std::vector<Listing>& get_listings() const noexcept;
+
+private:
+    struct Dir {
+        QString path;
+        int depth;
+    };
+
+    void request_next();
+    void handle_reply();
+    void handle_error(FileSystemModel::Error error, QNetworkReply::NetworkError network_error);
+
+private:
+    const QUrl _url;
+    const int _max_depth; // note: A negative value means the unlimited depth
+    const size_t _max_count;
+    std::unique_ptr<FileSystemModel> _model;
+    std::deque<Dir> _queue;
+    Dir _current;
+    std::vector<Listing> _listings;
+    FinishFunc _finish_func;
+};
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QUrl>
+
+#include "../src/Util.h"
+#include "Crawler.h"
+
+namespace {
+    QJsonObject to_json(const Crawler::Listing& listing) {
+        QJsonObject obj;
+        obj["path"] = listing.path;
+        obj["depth"] = listing.depth;
+        obj["entries"] = static_cast<qint64>(listing.entry_count);
+        if (!listing.error.isEmpty()) {
+            obj["error"] = listing.error;
+            return obj;
+        }
+        const RequestTiming& timing = listing.timing;
+        for (int i = 0; i < RequestTiming::phase_count; ++i)
+            obj[QString::fromLatin1(timing.get_phase_name(i)) + QStringLiteral("_us")] = static_cast<qint64>(timing.get_duration(i));
+
+        obj["total_us"] = static_cast<qint64>(timing.parse_done);
+        obj["bytes"] = static_cast<qint64>(timing.bytes);
+        obj["reused_connection"] = timing.connecting < 0;
+        obj["http2"] = timing.http2;
+        return obj;
+    }
+
+    void write_csv(QTextStream& out, const std::vector<Crawler::Listing>& listings) {
+        out << "path,depth,entries";
+        const RequestTiming header_timing;
+        for (int i = 0; i < RequestTiming::phase_count; ++i)
+            out << ',' << header_timing.get_phase_name(i) << "_us";
+
+        out << ",total_us,bytes,reused_connection,http2,error\n";
+        for (const Crawler::Listing& listing : listings) {
+            QString path = listing.path;
+            out << '"' << path.replace('"', QStringLiteral("\"\"")) << "\"," << listing.depth << ',' << listing.entry_count;
+            const RequestTiming& timing = listing.timing;
+            for (int i = 0; i < RequestTiming::phase_count; ++i)
+                out << ',' << timing.get_duration(i);
+
+            out << ',' << timing.parse_done << ',' << timing.bytes << ',' << (timing.connecting < 0 ? 1 : 0) << ',' << (timing.http2 ? 1 : 0) << ',' << listing.error << '\n';
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("web_dav_client_cli"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QObject::tr("Lists or crawls a WebDAV directory and prints the request timings"));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("command"), QObject::tr("list or crawl"));
+    parser.addPositionalArgument(QStringLiteral("url"), QObject::tr("The directory URL, e.g. http://127.0.0.1:8080/dav/"));
+    const QCommandLineOption format_option({QStringLiteral("f"), QStringLiteral("format")}, QObject::tr("The output format: json or csv."), QStringLiteral("format"), QStringLiteral("json"));
+    const QCommandLineOption depth_option({QStringLiteral("d"), QStringLiteral("depth")}, QObject::tr("The maximum crawl depth, unlimited by default."), QStringLiteral("depth"), QStringLiteral("-1"));
+    const QCommandLineOption limit_option({QStringLiteral("l"), QStringLiteral("limit")}, QObject::tr("The maximum number of listings, unlimited by default."), QStringLiteral("limit"), QStringLiteral("0"));
+    parser.addOptions({format_option, depth_option, limit_option});
+    parser.process(app);
+
+    QTextStream err(stderr);
+    const QStringList args = parser.positionalArguments();
+    const QString format = parser.value(format_option);
+    const QUrl url(args.value(1));
+    if (args.size() != 2 || (args[0] != QStringLiteral("list") && args[0] != QStringLiteral("crawl")) || (format != QStringLiteral("json") && format != QStringLiteral("csv"))) {
+        err << parser.helpText();
+        return 2;
+    }
+    if (!url.isValid() || url.scheme() != QStringLiteral("http")) {
+        err << QObject::tr("Only an http URL is supported: %1").arg(args[1]) << '\n'; // note: The client builds the http URLs only
+        return 2;
+    }
+    const int max_depth = args[0] == QStringLiteral("list") ? 0 : parser.value(depth_option).toInt();
+    const qlonglong limit = parser.value(limit_option).toLongLong();
+    Crawler crawler(url, max_depth, limit > 0 ? static_cast<size_t>(limit) : std::numeric_limits<size_t>::max());
+    QElapsedTimer timer;
+    timer.start();
+    crawler.start([&app]() { app.quit(); });
+    app.exec();
+    const qint64 wall_ms = timer.elapsed();
+
+    const std::vector<Crawler::Listing>& listings = crawler.get_listings();
+    const size_t entry_count = std::accumulate(std::begin(listings), std::end(listings), size_t(0), [](size_t count, const Crawler::Listing& listing) { return count + listing.entry_count; });
+    const auto error_count = std::count_if(std::begin(listings), std::end(listings), [](const Crawler::Listing& listing) { return !listing.error.isEmpty(); });
+    QTextStream out(stdout);
+    if (format == QStringLiteral("json")) {
+        QJsonArray array;
+        for (const Crawler::Listing& listing : listings)
+            array.append(to_json(listing));
+
+        QJsonObject summary;
+        summary["listings"] = static_cast<qint64>(listings.size());
+        summary["entries"] = static_cast<qint64>(entry_count);
+        summary["errors"] = static_cast<qint64>(error_count);
+        summary["wall_ms"] = wall_ms;
+        summary["peak_rss_kib"] = static_cast<qint64>(get_peak_rss_kib());
+        QJsonObject root;
+        root["url"] = url.toString();
+        root["command"] = args[0];
+        root["listings"] = array;
+        root["summary"] = summary;
+        out << QJsonDocument(root).toJson();
+    } else {
+        write_csv(out, listings);
+        err << QObject::tr("listings %1, entries %2, errors %3, wall %4 ms, peak RSS %5 KiB").arg(listings.size()).arg(entry_count).arg(error_count).arg(wall_ms).arg(get_peak_rss_kib()) << '\n'; // note: The summary doesn't break the CSV table
+    }
+    return error_count == 0 ? 0 : 1;
+}
@@ -14,6 +14,9 @@
 App::App(int& argc, char** argv) : QGuiApplication(argc, argv) {
     auto logger = Logger::get_instance();
     logger->install_handler();
+    _log_timer.setInterval(400);
+    connect(&_log_timer, &QTimer::timeout, this, [logger]() { logger->collect(); }); // note: The messages are collected even if the log page is closed, so the ring buffer doesn't overflow
+    _log_timer.start();
     auto settings = std::make_shared<SettingsJsonFile>(logger);
     _qml_settings = std::make_unique<Qml::Settings>(settings);
     auto srv_mgr = std::make_unique<ServerInfoManager>();
@@ -22,7 +25,7 @@ App::App(int& argc, char** argv) : QGuiApplication(argc, argv) {
     _item_model_mgr = std::make_unique<Qml::ItemModelManager>(logger, settings, std::move(srv_mgr), fs_model);
 }
 
-App::~App() = default;
+App::~App() { Logger::get_instance()->set_file_sink(nullptr); } // note: The sink writes the rest messages, while the application still exists
 
 void App::initialize_engine(QQmlApplicationEngine& engine) {
     QObject::connect(&engine, &QQmlApplicationEngine::objectCreationFailed, this, []() { QCoreApplication::exit(-1); }, Qt::QueuedConnection);
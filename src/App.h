@@ -4,6 +4,7 @@
 
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
+#include <QTimer>
 
 namespace Qml {
     class FileSystemModel;
@@ -22,4 +23,5 @@ private:
     std::unique_ptr<Qml::Settings> _qml_settings;
     std::unique_ptr<Qml::FileSystemModel> _qml_fs_client;
     std::unique_ptr<Qml::ItemModelManager> _item_model_mgr;
+    QTimer _log_timer;
 };
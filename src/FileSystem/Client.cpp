@@ -1,5 +1,9 @@
 #include "Client.h"
 
+#include "../Logger.h"
+#include "../Metrics.h"
+#include "../Trace.h"
+
 Client::Client(ReplyHandler&& reply_handler, ErrorHandler&& error_handler) noexcept
     : _reply_handler(std::move(reply_handler)), _error_handler(std::move(error_handler)) {}
 
@@ -9,25 +13,77 @@ void Client::set_server_info(const QStringView& addr, uint16_t port) noexcept {
 }
 
 void Client::request_file_list(const QStringView& path) {
-    QNetworkRequest req;
-    const QString url = "http://" + _addr + ':' + QString::number(_port) + path.toString();
-    req.setUrl(QUrl(url)); // todo: set username and password
-    qInfo(qUtf8Printable(QObject::tr("The request is occurring: %s")), qUtf8Printable(url));
+    QNetworkRequest req = create_request(path);
     req.setRawHeader("Depth", "1");
     const QByteArray data = _file_list_request;
     req.setHeader(QNetworkRequest::ContentLengthHeader, data.size());
     req.setHeader(QNetworkRequest::ContentTypeHeader, "text/xml");
+    const auto timing = std::make_shared<RequestTiming>();
+    timing->start();
     _reply.reset(_network_access_mgr.sendCustomRequest(req, "PROPFIND", data));
-    const auto read = [this]() {
+    QNetworkReply* const reply = _reply.get();
+    QObject::connect(reply, &QNetworkReply::socketStartedConnecting, [timing]() { timing->connecting = timing->get_elapsed(); });
+    QObject::connect(reply, &QNetworkReply::encrypted, [timing]() { timing->encrypted = timing->get_elapsed(); });
+    QObject::connect(reply, &QNetworkReply::requestSent, [timing]() { timing->request_sent = timing->get_elapsed(); });
+    QObject::connect(reply, &QNetworkReply::metaDataChanged, [timing]() { // note: The headers are the first bytes of the reply
+        if (timing->first_byte < 0)
+            timing->first_byte = timing->get_elapsed();
+    });
+    const auto read = [this, timing]() {
+        timing->last_byte = timing->get_elapsed();
+        Trace::finish("Client: PROPFIND", timing->trace_start);
         const QNetworkReply::NetworkError error = _reply->error();
-        if (error == QNetworkReply::NoError)
-            _reply_handler(_reply->readAll());
-        else
+        static const auto metrics = Metrics::get_instance();
+        metrics->get_histogram(QStringLiteral("client.propfind_latency_us{%1:%2}").arg(_addr).arg(_port)).record(timing->last_byte);
+        if (error == QNetworkReply::NoError) {
+            QByteArray reply = _reply->readAll();
+            static Metrics::Counter& bytes_received = metrics->get_counter(QStringLiteral("client.bytes_received"));
+            bytes_received.add(reply.size());
+            timing->bytes = reply.size();
+            timing->http2 = _reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool();
+            _timing = *timing;
+            _reply_handler(std::move(reply));
+        } else {
             _error_handler(error);
+        }
     };
     QObject::connect(_reply.get(), &QNetworkReply::finished, read);
 }
 
+void Client::request_options(const QStringView& path, OptionsHandler&& handler) {
+    const QNetworkRequest req = create_request(path);
+    _options_reply.reset(_network_access_mgr.sendCustomRequest(req, "OPTIONS"));
+    const auto read = [this, handler = std::move(handler)]() {
+        const auto supported = _options_reply->error() == QNetworkReply::NoError && _options_reply->rawHeader("DASL").contains("DAV:basicsearch");
+        Logger::log(QtDebugMsg, supported ? QT_TR_NOOP("The server supports the SEARCH method") : QT_TR_NOOP("The server doesn't support the SEARCH method"));
+        handler(supported);
+    };
+    QObject::connect(_options_reply.get(), &QNetworkReply::finished, read);
+}
+
+void Client::request_search(const QStringView& path, const QStringView& text, bool case_sensitive, ReplyHandler&& data_handler, SearchFinishHandler&& finish_handler) {
+    QNetworkRequest req = create_request(path);
+    QString literal = text.toString();
+    literal.replace('\\', QStringLiteral("\\\\")).replace('%', QStringLiteral("\\%")).replace('_', QStringLiteral("\\_")); // note: RFC 5323, 5.15.1: the wildcards and the escape character itself are escaped with '\'
+    const QByteArray data = QString(_search_request).arg(path.toString().toHtmlEscaped(), case_sensitive ? QStringLiteral("no") : QStringLiteral("yes"), literal.toHtmlEscaped()).toUtf8();
+    req.setHeader(QNetworkRequest::ContentLengthHeader, data.size());
+    req.setHeader(QNetworkRequest::ContentTypeHeader, "text/xml; charset=\"utf-8\"");
+    const int64_t start = Trace::start();
+    _search_reply.reset(_network_access_mgr.sendCustomRequest(req, "SEARCH", data));
+    QObject::connect(_search_reply.get(), &QNetworkReply::readyRead, [this, data_handler = std::move(data_handler)]() {
+        QByteArray data = _search_reply->readAll();
+        static Metrics::Counter& bytes_received = Metrics::get_instance()->get_counter(QStringLiteral("client.bytes_received"));
+        bytes_received.add(data.size());
+        if (_search_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() / 100 != 2)
+            return; // note: The body of an error isn't a multistatus, so its parse error mustn't hide the status
+        data_handler(std::move(data));
+    });
+    QObject::connect(_search_reply.get(), &QNetworkReply::finished, [this, start, finish_handler = std::move(finish_handler)]() {
+        Trace::finish("Client: SEARCH", start);
+        finish_handler(_search_reply->error(), _search_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt());
+    });
+}
+
 void Client::abort() {
     if (!_reply)
         return;
@@ -36,3 +92,31 @@ void Client::abort() {
     _reply->abort();
     _reply.reset();
 }
+
+void Client::abort_options() { abort(_options_reply); }
+
+void Client::abort_search() {
+    if (_search_reply)
+        qDebug().noquote() << QObject::tr("The search request is being aborted");
+
+    abort(_search_reply);
+}
+
+const RequestTiming& Client::get_timing() const noexcept { return _timing; }
+
+QNetworkRequest Client::create_request(const QStringView& path) const {
+    QNetworkRequest req;
+    const QString url = "http://" + _addr + ':' + QString::number(_port) + path.toString();
+    req.setUrl(QUrl(url)); // todo: set username and password
+    Logger::log(QtInfoMsg, QT_TR_NOOP("The request is occurring: %1"), url);
+    return req;
+}
+
+void Client::abort(ReplyPtr& reply) {
+    if (!reply)
+        return;
+
+    QObject::disconnect(reply.get(), nullptr, nullptr, nullptr); // note: The handlers must not be called, because the request is aborted by the owner
+    reply->abort();
+    reply.reset();
+}
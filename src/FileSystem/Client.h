@@ -7,20 +7,36 @@
 #include <QByteArray>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
+#include <QNetworkRequest>
 #include <QScopedPointer>
 #include <QString>
 #include <QStringView>
 
+#include "RequestTiming.h"
+
 class Client {
 public:
     using ReplyHandler = std::function<void (QByteArray&&)>;
     using ErrorHandler = std::function<void (QNetworkReply::NetworkError)>;
+    using OptionsHandler = std::function<void (bool search_supported)>;
+    using SearchFinishHandler = std::function<void (QNetworkReply::NetworkError, int http_status)>; // note: The status is 0, if no response has been got
 
     Client(ReplyHandler&& reply_handler, ErrorHandler&& error_handler) noexcept;
 
     void set_server_info(const QStringView& addr, uint16_t port) noexcept;
     void request_file_list(const QStringView& path);
+    void request_options(const QStringView& path, OptionsHandler&& handler);
+    void request_search(const QStringView& path, const QStringView& text, bool case_sensitive, ReplyHandler&& data_handler, SearchFinishHandler&& finish_handler);
     void abort();
+    void abort_options();
+    void abort_search();
+    const RequestTiming& get_timing() const noexcept;
+
+private:
+    using ReplyPtr = std::unique_ptr<QNetworkReply, QScopedPointerDeleteLater>;
+
+    QNetworkRequest create_request(const QStringView& path) const;
+    static void abort(ReplyPtr& reply);
 
 private:
     constexpr static char _file_list_request[] = "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
@@ -32,11 +48,39 @@ private:
                                                          "<D:getcontentlength/>\n"
                                                      "</D:prop>\n"
                                                  "</D:propfind>";
+    constexpr static char _search_request[] = "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+                                              "<D:searchrequest xmlns:D=\"DAV:\">\n"
+                                                  "<D:basicsearch>\n"
+                                                      "<D:select>\n"
+                                                          "<D:prop>\n"
+                                                              "<D:creationdate/>\n"
+                                                              "<D:getlastmodified/>\n"
+                                                              "<D:resourcetype/>\n"
+                                                              "<D:getcontentlength/>\n"
+                                                          "</D:prop>\n"
+                                                      "</D:select>\n"
+                                                      "<D:from>\n"
+                                                          "<D:scope>\n"
+                                                              "<D:href>%1</D:href>\n"
+                                                              "<D:depth>infinity</D:depth>\n"
+                                                          "</D:scope>\n"
+                                                      "</D:from>\n"
+                                                      "<D:where>\n"
+                                                          "<D:like caseless=\"%2\">\n"
+                                                              "<D:prop><D:displayname/></D:prop>\n"
+                                                              "<D:literal>%%3%</D:literal>\n"
+                                                          "</D:like>\n"
+                                                      "</D:where>\n"
+                                                  "</D:basicsearch>\n"
+                                              "</D:searchrequest>";
 
     const ReplyHandler _reply_handler;
     const ErrorHandler _error_handler;
     QString _addr;
     uint16_t _port;
     QNetworkAccessManager _network_access_mgr;
-    std::unique_ptr<QNetworkReply, QScopedPointerDeleteLater> _reply;
+    ReplyPtr _reply;
+    ReplyPtr _options_reply;
+    ReplyPtr _search_reply;
+    RequestTiming _timing; // note: The timing of the last finished file list request
 };
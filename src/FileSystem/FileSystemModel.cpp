@@ -1,28 +1,28 @@
 #include "FileSystemModel.h"
 
+#include "../Logger.h"
+#include "../Metrics.h"
+#include "../Trace.h"
 #include "Client.h"
 #include "Parser/Parser.h"
+#include "Parser/SearchReplyParser.h"
+
+struct FileSystemModel::SearchState {
+    QString text;
+    bool case_sensitive;
+    size_t limit;
+    size_t count = 0;
+    SearchMatchFunc match_func;
+    SearchFinishFunc finish_func;
+    std::vector<NameIndex::Match> matches;
+    std::unique_ptr<Parser::SearchReplyParser> parser;
+};
 
 FileSystemModel::FileSystemModel()
     : _client(std::make_unique<Client>(std::bind(&FileSystemModel::handle_reply, this, std::placeholders::_1),
-                                       std::bind(&FileSystemModel::handle_error, this, std::placeholders::_1)))
+                                       std::bind(&FileSystemModel::handle_error, this, std::placeholders::_1))),
+      _objects(std::make_shared<const std::deque<FileSystemObject>>())
 {
-#ifndef NDEBUG
-    Parser::test();
-
-    QString test = "/";
-    assert(handle_double_dots(test) == "/");
-    test = "/test/test2/../../test3/test4/";
-    assert(handle_double_dots(test) == "/test3/test4/");
-    test = "/test/../test2/../test3/";
-    assert(handle_double_dots(test) == "/test3/");
-    test = "/test/..g/";
-    assert(handle_double_dots(test) == test);
-    test = "/test/g../";
-    assert(handle_double_dots(test) == test);
-    test = "/test/..../";
-    assert(handle_double_dots(test) == test);
-#endif
 }
 
 FileSystemModel::~FileSystemModel() = default;
@@ -31,12 +31,18 @@ bool FileSystemModel::is_cur_dir_root_path() const noexcept { return _root_path
 
 QString FileSystemModel::get_current_path() const noexcept { return _current_path; }
 
-void FileSystemModel::set_server_info(const QStringView& addr, uint16_t port) { _client->set_server_info(addr, port); }
+void FileSystemModel::set_server_info(const QStringView& addr, uint16_t port) {
+    _server = addr.toString() + ':' + QString::number(port);
+    _client->set_server_info(addr, port);
+}
 
 void FileSystemModel::set_root_path(const QStringView& absolute_path) {
     _root_path = add_slash_to_end(add_slash_to_start(absolute_path.toString()));
     _current_path = _root_path;
     _prev_path.clear();
+    _name_index = std::make_unique<NameIndex>(_server + _root_path);
+    _search_supported = false;
+    _client->request_options(_root_path, [this](bool search_supported) { _search_supported = search_supported; });
 }
 
 void FileSystemModel::request_file_list(const QStringView& relative_path) {
@@ -45,13 +51,25 @@ void FileSystemModel::request_file_list(const QStringView& relative_path) {
     _client->request_file_list(_current_path);
 }
 
+void FileSystemModel::request_abs_file_list(const QStringView& absolute_path) {
+    assert(absolute_path.startsWith(_root_path));
+
+    _prev_path = _current_path;
+    _current_path = add_slash_to_end(absolute_path.toString());
+    _client->request_file_list(_current_path);
+}
+
 void FileSystemModel::abort_request() { _client->abort(); }
 
 void FileSystemModel::disconnect() {
     abort_request();
+    abort_search();
+    _client->abort_options();
+    _search_supported = false;
     qDebug().noquote() << QObject::tr("The file system model is being reset");
-    _objects.clear();
+    _objects = std::make_shared<const std::deque<FileSystemObject>>();
     _curr_dir_obj.reset();
+    _name_index.reset();
     _prev_path.clear();
     _current_path.clear();
 }
@@ -71,9 +89,41 @@ FileSystemObject FileSystemModel::get_curr_dir_object() const noexcept {
     return *_curr_dir_obj;
 }
 
-FileSystemObject FileSystemModel::get_object(size_t index) const noexcept { return _objects[index]; }
+FileSystemObject FileSystemModel::get_object(size_t index) const noexcept { return (*_objects)[index]; }
+
+std::shared_ptr<const std::deque<FileSystemObject>> FileSystemModel::get_objects() const noexcept { return _objects; }
+
+size_t FileSystemModel::size() const noexcept { return _objects->size(); }
 
-size_t FileSystemModel::size() const noexcept { return _objects.size(); }
+const RequestTiming& FileSystemModel::get_request_timing() const noexcept { return _request_timing; }
+
+void FileSystemModel::search(const QStringView& text, bool case_sensitive, size_t limit, SearchMatchFunc&& match_func, SearchFinishFunc&& finish_func) {
+    abort_search();
+    _search = std::make_unique<SearchState>(SearchState{text.toString(), case_sensitive, limit, 0, std::move(match_func), std::move(finish_func)});
+    if (!_search_supported || text.isEmpty()) {
+        search_index(*_search);
+        finish_search(true);
+        return;
+    }
+    const auto add_match = [this](QString&& abs_path, FileSystemObject&& obj) {
+        SearchState& state = *_search;
+        QString name = obj.get_name();
+        if (state.count == state.limit || !name.contains(state.text, state.case_sensitive ? Qt::CaseSensitive : Qt::CaseInsensitive)) // note: Some servers ignore the caseless attribute
+            return;
+
+        state.matches.push_back(NameIndex::Match{std::move(abs_path), std::move(name), obj.get_type() == FileSystemObject::Type::Directory});
+        ++state.count;
+    };
+    _search->parser = std::make_unique<Parser::SearchReplyParser>(_root_path, add_match);
+    _client->request_search(_root_path, text, case_sensitive,
+                            std::bind(&FileSystemModel::handle_search_data, this, std::placeholders::_1),
+                            std::bind(&FileSystemModel::handle_search_finish, this, std::placeholders::_1, std::placeholders::_2));
+}
+
+void FileSystemModel::abort_search() {
+    _client->abort_search();
+    _search.reset();
+}
 
 QString&& FileSystemModel::add_slash_to_start(QString&& path) {
     if (path.isEmpty() || path.front() != '/')
@@ -133,14 +183,30 @@ QString FileSystemModel::handle_double_dots(const QStringView& path) {
 }
 
 void FileSystemModel::handle_reply(QByteArray&& data) {
+    const Trace::Span span("FileSystemModel::handle_reply");
     try {
+        QElapsedTimer timer;
+        timer.start();
         Parser::Result result = Parser::parse_propfind_reply(_current_path, data);
+        const qint64 elapsed = std::max(timer.nsecsElapsed(), qint64(1));
+        static const auto metrics = Metrics::get_instance();
+        static Metrics::Histogram& throughput = metrics->get_histogram(QStringLiteral("parser.propfind_throughput_kib_s"));
+        static Metrics::Histogram& entries = metrics->get_histogram(QStringLiteral("listing.entries"));
+        throughput.record(data.size() * 1'000'000'000 / elapsed / 1024);
+        entries.record(result.second.size());
+        _request_timing = _client->get_timing();
+        _request_timing.parse_done = _request_timing.get_elapsed();
+        _request_timing.publish(_server);
+        Logger::log(QtDebugMsg, QT_TR_NOOP("The request timing: %1"), _request_timing.to_string());
         _curr_dir_obj = std::move(result.first);
-        _objects = std::move(result.second);
+        _objects = std::make_shared<const std::deque<FileSystemObject>>(std::move(result.second));
+        if (_name_index)
+            _name_index->update_dir(_current_path, *_objects);
+
         std::for_each(std::begin(_notify_func_by_obj_map), std::end(_notify_func_by_obj_map), [](const auto& pair) { pair.second(); });
     } catch (const std::runtime_error& e) {
         _current_path = _prev_path;
-        qCritical(qUtf8Printable(QObject::tr("An error has occured during reply parse: %s. The reply text: \n%s")), qUtf8Printable(QObject::tr(e.what())), qUtf8Printable(data));
+        Logger::log(QtCriticalMsg, QT_TR_NOOP("An error has occured during reply parse: %1. The reply text: \n%2"), QObject::tr(e.what()), data);
         if (_error_func)
             _error_func(Error::ReplyParseError, QNetworkReply::NetworkError::NoError);
     }
@@ -151,3 +217,68 @@ void FileSystemModel::handle_error(QNetworkReply::NetworkError error) {
     if (_error_func)
         _error_func(Error::NetworkError, error);
 }
+
+void FileSystemModel::search_index(SearchState& state) {
+    if (!_name_index)
+        return;
+
+    std::vector<NameIndex::Match> matches = _name_index->search(state.text, state.case_sensitive, state.limit);
+    state.count = matches.size();
+    if (!matches.empty())
+        state.match_func(std::move(matches));
+}
+
+void FileSystemModel::handle_search_data(QByteArray&& data) {
+    assert(_search);
+
+    SearchState& state = *_search;
+    try {
+        state.parser->add_data(data);
+    } catch (const std::runtime_error& e) {
+        Logger::log(QtCriticalMsg, QT_TR_NOOP("An error has occured during search reply parse: %1"), QObject::tr(e.what()));
+        handle_search_finish(QNetworkReply::NetworkError::UnknownContentError, 0);
+        return;
+    }
+    if (!state.matches.empty())
+        state.match_func(std::exchange(state.matches, {}));
+
+    if (state.count == state.limit)
+        finish_search(true);
+}
+
+void FileSystemModel::handle_search_finish(QNetworkReply::NetworkError error, int http_status) {
+    assert(_search);
+
+    SearchState& state = *_search;
+    if (error == QNetworkReply::NetworkError::NoError) {
+        try {
+            state.parser->finish();
+        } catch (const std::runtime_error& e) {
+            Logger::log(QtCriticalMsg, QT_TR_NOOP("An error has occured during search reply parse: %1"), QObject::tr(e.what()));
+            error = QNetworkReply::NetworkError::UnknownContentError;
+        }
+    }
+    if (error == QNetworkReply::NetworkError::NoError) {
+        finish_search(true);
+        return;
+    }
+    if (state.count != 0) {
+        finish_search(false);
+        return;
+    }
+    const auto unsupported = http_status == 400 || http_status == 405 || http_status == 422 || http_status == 501; // note: The method or the query grammar isn't supported; a timeout, an unavailable server or a reset connection are transient
+    if (unsupported) {
+        qWarning().noquote() << QObject::tr("The server doesn't support the search (HTTP status %1), the local name index is used instead").arg(http_status);
+        _search_supported = false;
+    } else {
+        qWarning().noquote() << QObject::tr("The server search has failed, the local name index is used for this query");
+    }
+    search_index(state);
+    finish_search(true);
+}
+
+void FileSystemModel::finish_search(bool ok) {
+    _client->abort_search();
+    const std::unique_ptr<SearchState> state = std::move(_search);
+    state->finish_func(ok);
+}
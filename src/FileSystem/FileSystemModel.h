@@ -4,6 +4,7 @@
 #include <deque>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include <QByteArray>
 #include <QNetworkReply>
@@ -11,6 +12,8 @@
 #include <QStringView>
 
 #include "FileSystemObject.h" // note: Building under Android fails with forward declaration
+#include "NameIndex.h"
+#include "RequestTiming.h"
 
 class Client;
 class Parser;
@@ -21,6 +24,8 @@ public:
 
     using NotifyAboutUpdateFunc = std::function<void ()>;
     using NotifyAboutErrorFunc = std::function<void (Error, QNetworkReply::NetworkError)>;
+    using SearchMatchFunc = std::function<void (std::vector<NameIndex::Match>&&)>;
+    using SearchFinishFunc = std::function<void (bool ok)>;
 
     FileSystemModel();
     ~FileSystemModel();
@@ -30,6 +35,7 @@ public:
     void set_server_info(const QStringView& addr, uint16_t port);
     void set_root_path(const QStringView& absolute_path);
     void request_file_list(const QStringView& relative_path);
+    void request_abs_file_list(const QStringView& absolute_path);
     void abort_request();
     void disconnect();
     void add_notification_func(const void* obj, NotifyAboutUpdateFunc&& func) noexcept;
@@ -37,22 +43,37 @@ public:
     void set_error_func(NotifyAboutErrorFunc&& func) noexcept;
     FileSystemObject get_curr_dir_object() const noexcept;
     FileSystemObject get_object(size_t index) const noexcept;
+    std::shared_ptr<const std::deque<FileSystemObject>> get_objects() const noexcept;
     size_t size() const noexcept;
+    const RequestTiming& get_request_timing() const noexcept;
+    void search(const QStringView& text, bool case_sensitive, size_t limit, SearchMatchFunc&& match_func, SearchFinishFunc&& finish_func);
+    void abort_search();
+    static QString handle_double_dots(const QStringView& path);
 
 private:
+    struct SearchState;
+
     static QString&& add_slash_to_start(QString&& path);
     static QString&& add_slash_to_end(QString&& path);
-    static QString handle_double_dots(const QStringView& path);
     void handle_reply(QByteArray&& data);
     void handle_error(QNetworkReply::NetworkError error);
+    void search_index(SearchState& state);
+    void handle_search_data(QByteArray&& data);
+    void handle_search_finish(QNetworkReply::NetworkError error, int http_status);
+    void finish_search(bool ok);
 
 private:
     std::unique_ptr<Client> _client;
+    QString _server;
     QString _root_path;
+    std::unique_ptr<NameIndex> _name_index;
+    bool _search_supported = false;
+    std::unique_ptr<SearchState> _search;
     std::unordered_map<const void*, const NotifyAboutUpdateFunc> _notify_func_by_obj_map;
     NotifyAboutErrorFunc _error_func;
     QString _prev_path;
     QString _current_path;
     std::unique_ptr<FileSystemObject> _curr_dir_obj;
-    std::deque<FileSystemObject> _objects;
+    std::shared_ptr<const std::deque<FileSystemObject>> _objects; // note: A listing is never modified, so a snapshot of it can be read on another thread
+    RequestTiming _request_timing; // note: The timing of the request, which has got the current listing
 };
@@ -3,3 +3,14 @@
 FileSystemObject::FileSystemObject(QString&& name, Type type, std::pair<Status, std::chrono::sys_seconds>&& creation_time, std::pair<Status, std::chrono::sys_seconds>&& modification_time, std::pair<Status, uint64_t>&& size) noexcept
     : _name(std::move(name)), _type(type), _creation_time(std::move(creation_time)), _modification_time(std::move(modification_time)), _size(std::move(size))
 {}
+
+QString FileSystemObject::get_extension() const {
+    if (_type == Type::Directory)
+        return QString();
+
+    const qsizetype pos = _name.lastIndexOf('.');
+    if (pos == -1 || pos == _name.size() - 1)
+        return QString();
+
+    return QStringView(std::begin(_name) + pos + 1, std::end(_name)).toString().toLower();
+}
@@ -14,6 +14,7 @@ public:
     FileSystemObject(QString&& name, Type type, std::pair<Status, std::chrono::sys_seconds>&& creation_time, std::pair<Status, std::chrono::sys_seconds>&& modification_time, std::pair<Status, uint64_t>&& size) noexcept;
 
     QString get_name() const noexcept { return _name; }
+    QString get_extension() const;
     Type get_type() const noexcept { return _type; }
     bool is_creation_time_valid() const noexcept { return _creation_time.first == Status::Ok; }
     std::chrono::sys_seconds get_creation_time() const { return _creation_time.second; }
@@ -0,0 +1,452 @@
+#include "NameIndex.h"
+
+#include "../Logger.h"
+#include "../Util.h"
+#include "FileSystemObject.h"
+
+namespace {
+    enum class Section {Entries, Trigrams, Postings, Dirs, Chars, End};
+
+    constexpr qsizetype trigram_size = 3;
+}
+
+NameIndex::NameIndex(const QString& id) : _guard(std::make_shared<Guard>()) {
+    _guard->index = this;
+    _build_timer.setSingleShot(true);
+    _build_timer.setInterval(_build_delay);
+    QObject::connect(&_build_timer, &QTimer::timeout, &_receiver, [this]() { start_build(); });
+    if (id.isEmpty())
+        return;
+
+    const QString dir_path = get_config_path() + QStringLiteral("/index");
+    if (!QDir().mkpath(dir_path)) {
+        qCritical(qUtf8Printable(QObject::tr("Could not create directory \"%s\"")), qUtf8Printable(dir_path));
+        return;
+    }
+    const QByteArray hash = QCryptographicHash::hash(id.toUtf8(), QCryptographicHash::Sha1).toHex();
+    _file.setFileName(dir_path + '/' + QString::fromLatin1(hash) + QStringLiteral(".idx"));
+    if (!_file.exists())
+        return;
+
+    if (!_file.open(QIODeviceBase::ReadOnly)) {
+        qWarning(qUtf8Printable(QObject::tr("Could not open file \"%s\"")), qUtf8Printable(_file.fileName()));
+        return;
+    }
+    const qint64 size = _file.size();
+    _mapped = size > 0 ? _file.map(0, size) : nullptr;
+    if (_mapped == nullptr || !set_image(reinterpret_cast<const char*>(_mapped), size)) {
+        qWarning(qUtf8Printable(QObject::tr("The name index file \"%s\" is corrupted, the index will be rebuilt")), qUtf8Printable(_file.fileName()));
+        _data = nullptr;
+        unmap();
+        return;
+    }
+    _stale_dirs.assign(header().dir_count, false);
+    Logger::log(QtDebugMsg, QT_TR_NOOP("The name index was loaded: %1 entries"), NameIndex::size());
+}
+
+NameIndex::~NameIndex() {
+    {
+        const std::lock_guard<std::mutex> locker(_guard->mutex);
+        _guard->index = nullptr; // note: A running build job mustn't post its image to the destroyed index
+    }
+    save();
+    unmap();
+}
+
+void NameIndex::update_dir(const QStringView& dir_path, const std::deque<FileSystemObject>& objects) {
+    assert(!dir_path.empty());
+    assert(dir_path.back() == '/');
+
+    thaw();
+    ++_generation;
+    const QString path = dir_path.toString();
+    std::unordered_set<QString> dir_names;
+    for (const FileSystemObject& obj : objects) {
+        if (obj.get_type() == FileSystemObject::Type::Directory)
+            dir_names.insert(obj.get_name());
+    }
+    if (const auto it = _dirs.find(path); it != std::end(_dirs)) {
+        const std::shared_ptr<const std::vector<Child>> old_children = it->second;
+        for (const Child& child : *old_children) { // note: The subtrees of the directories, which don't exist anymore, are indexed no longer
+            if (!child.is_dir || dir_names.contains(child.name))
+                continue;
+
+            const QString prefix = path + child.name + '/';
+            std::erase_if(_dirs, [&prefix](const auto& pair) { return pair.first.startsWith(prefix); });
+            add_change(prefix, true);
+        }
+    }
+    auto children = std::make_shared<std::vector<Child>>();
+    children->reserve(objects.size());
+    std::transform(std::cbegin(objects), std::cend(objects), std::back_inserter(*children), [](const FileSystemObject& obj) {
+        return Child{obj.get_name(), obj.get_name().toCaseFolded(), obj.get_type() == FileSystemObject::Type::Directory};
+    });
+    _dirs[path] = std::move(children);
+    add_change(path, false);
+    _modified = true;
+    _build_timer.start();
+}
+
+std::vector<NameIndex::Match> NameIndex::search(const QStringView& text, bool case_sensitive, size_t limit) {
+    if (text.isEmpty())
+        return {};
+
+    const QString folded_text = text.toString().toCaseFolded();
+    const bool prefix = folded_text.size() < trigram_size; // note: There are no trigrams in short strings, so the prefixes of the names are searched instead
+    std::vector<std::pair<QString, Match>> recent_matches; // note: The changed directories are scanned, they are the few recently visited ones
+    for (const auto& [path, change] : _changes) {
+        const auto it = _dirs.find(path);
+        if (it == std::end(_dirs))
+            continue;
+
+        for (const Child& child : *it->second) {
+            const bool found = case_sensitive ? (prefix ? child.name.startsWith(text) : child.name.contains(text))
+                                              : (prefix ? child.folded.startsWith(folded_text) : child.folded.contains(folded_text));
+            if (found)
+                recent_matches.emplace_back(child.folded, Match{path + child.name + (child.is_dir ? QStringLiteral("/") : QString()), child.name, child.is_dir});
+        }
+    }
+    const auto less = [](const std::pair<QString, Match>& lhs, const std::pair<QString, Match>& rhs) { return lhs.first != rhs.first ? lhs.first < rhs.first : lhs.second.name < rhs.second.name; };
+    std::sort(std::begin(recent_matches), std::end(recent_matches), less);
+    if (recent_matches.size() > limit)
+        recent_matches.resize(limit);
+
+    std::vector<Match> image_matches = search_image(text, folded_text, case_sensitive, limit);
+    std::vector<std::pair<QString, Match>> image_pairs;
+    image_pairs.reserve(image_matches.size());
+    for (Match& match : image_matches)
+        image_pairs.emplace_back(match.name.toCaseFolded(), std::move(match));
+
+    std::vector<std::pair<QString, Match>> merged;
+    merged.reserve(image_pairs.size() + recent_matches.size());
+    std::merge(std::make_move_iterator(std::begin(image_pairs)), std::make_move_iterator(std::end(image_pairs)),
+               std::make_move_iterator(std::begin(recent_matches)), std::make_move_iterator(std::end(recent_matches)), std::back_inserter(merged), less); // note: Both are in the order of the folded names, as the image entries are
+    std::vector<Match> matches;
+    matches.reserve(std::min(merged.size(), limit));
+    for (auto it = std::begin(merged), end = std::end(merged); it != end && matches.size() < limit; ++it)
+        matches.push_back(std::move(it->second));
+
+    return matches;
+}
+
+std::vector<NameIndex::Match> NameIndex::search_image(const QStringView& text, const QString& folded_text, bool case_sensitive, size_t limit) const {
+    std::vector<Match> matches;
+    if (_data == nullptr)
+        return matches;
+
+    const EntryRecord* const entry_records = entries();
+    const DirRecord* const dir_records = dirs();
+    const auto try_add = [&](uint32_t i, bool prefix) {
+        const EntryRecord& entry = entry_records[i];
+        if (_stale_dirs[entry.dir])
+            return; // note: The current entries of the directory are found among the changes
+
+        const QStringView name = to_view(entry.name_offset, entry.name_size);
+        if (case_sensitive) {
+            if (prefix ? !name.startsWith(text) : !name.contains(text))
+                return;
+        } else if (!prefix && !to_view(entry.folded_offset, entry.folded_size).contains(folded_text)) {
+            return;
+        }
+        const DirRecord& dir = dir_records[entry.dir];
+        const QStringView dir_path = to_view(dir.path_offset, dir.path_size);
+        QString path;
+        path.reserve(dir_path.size() + name.size() + 1);
+        path += dir_path;
+        path += name;
+        if (entry.is_dir)
+            path += '/';
+
+        matches.push_back(Match{std::move(path), name.toString(), entry.is_dir != 0});
+    };
+
+    const Header& h = header();
+    if (folded_text.size() < trigram_size) {
+        const EntryRecord* const end = entry_records + h.entry_count;
+        auto it = std::lower_bound(entry_records, end, QStringView(folded_text), [this](const EntryRecord& entry, const QStringView& str) { return to_view(entry.folded_offset, entry.folded_size) < str; });
+        for (; it != end && matches.size() < limit && to_view(it->folded_offset, it->folded_size).startsWith(folded_text); ++it)
+            try_add(to_type<uint32_t>(it - entry_records), true);
+
+        return matches;
+    }
+
+    std::vector<const TrigramRecord*> records;
+    const auto* const str = reinterpret_cast<const char16_t*>(folded_text.constData());
+    for (qsizetype i = 0; i + trigram_size <= folded_text.size(); ++i) {
+        const TrigramRecord* const record = find_trigram(to_trigram(str + i));
+        if (record == nullptr)
+            return matches;
+
+        records.push_back(record);
+    }
+    std::sort(std::begin(records), std::end(records));
+    records.erase(std::unique(std::begin(records), std::end(records)), std::end(records));
+    std::sort(std::begin(records), std::end(records), [](const TrigramRecord* lhs, const TrigramRecord* rhs) { return lhs->posting_count < rhs->posting_count; });
+
+    const uint32_t* const posting_records = postings();
+    const TrigramRecord* const rarest = records.front();
+    std::vector<uint32_t> candidates(posting_records + rarest->first_posting, posting_records + rarest->first_posting + rarest->posting_count);
+    std::vector<uint32_t> intersection;
+    for (auto it = std::next(std::cbegin(records)), end = std::cend(records); it != end && !candidates.empty(); ++it) {
+        const uint32_t* const first = posting_records + (*it)->first_posting;
+        intersection.clear();
+        std::set_intersection(std::cbegin(candidates), std::cend(candidates), first, first + (*it)->posting_count, std::back_inserter(intersection));
+        candidates.swap(intersection);
+    }
+    for (auto it = std::cbegin(candidates), end = std::cend(candidates); it != end && matches.size() < limit; ++it)
+        try_add(*it, false);
+
+    return matches;
+}
+
+size_t NameIndex::size() const noexcept {
+    if (_thawed)
+        return std::accumulate(std::cbegin(_dirs), std::cend(_dirs), size_t(0), [](size_t sum, const auto& pair) { return sum + pair.second->size(); });
+
+    return _data == nullptr ? 0 : header().entry_count;
+}
+
+bool NameIndex::save() {
+    if (!_modified || _file.fileName().isEmpty())
+        return true;
+
+    if (!_changes.empty())
+        install_image(build_image(_dirs), _generation); // note: The index is being closed, so the changes, which aren't built yet, are built here
+
+    QSaveFile file(_file.fileName());
+    if (!file.open(QIODeviceBase::WriteOnly) || file.write(_image) != _image.size() || !file.commit()) {
+        qCritical(qUtf8Printable(QObject::tr("Could not write file \"%s\"")), qUtf8Printable(file.fileName()));
+        return false;
+    }
+    _modified = false;
+    Logger::log(QtDebugMsg, QT_TR_NOOP("The name index was saved: %1 entries"), size());
+    return true;
+}
+
+uint64_t NameIndex::to_trigram(const char16_t* str) noexcept { return (to_type<uint64_t>(str[0]) << 32) | (to_type<uint64_t>(str[1]) << 16) | to_type<uint64_t>(str[2]); }
+
+size_t NameIndex::align(size_t size) noexcept { return (size + 7) & ~size_t(7); }
+
+size_t NameIndex::get_offset(const Header& h, int section) noexcept {
+    const std::array<size_t, to_int(Section::End)> sizes{h.entry_count * sizeof(EntryRecord), h.trigram_count * sizeof(TrigramRecord), h.posting_count * sizeof(uint32_t),
+                                                          h.dir_count * sizeof(DirRecord), h.char_count * sizeof(char16_t)};
+    size_t offset = align(sizeof(Header));
+    for (int i = 0; i < section; ++i)
+        offset += align(sizes[i]);
+
+    return offset;
+}
+
+bool NameIndex::set_image(const char* data, size_t size) noexcept {
+    if (size < sizeof(Header))
+        return false;
+
+    const auto& h = *reinterpret_cast<const Header*>(data);
+    if (std::memcmp(h.magic, _magic, sizeof(_magic)) != 0 || h.version != _version || get_offset(h, to_int(Section::End)) != size)
+        return false;
+
+    _data = data;
+    const auto is_in_chars = [&h](uint32_t offset, uint32_t length) { return to_type<uint64_t>(offset) + length <= h.char_count; };
+    const EntryRecord* const entry_records = entries();
+    const auto entries_are_valid = std::all_of(entry_records, entry_records + h.entry_count, [&h, &is_in_chars](const EntryRecord& r) { return is_in_chars(r.name_offset, r.name_size) && is_in_chars(r.folded_offset, r.folded_size) && r.dir < h.dir_count; });
+    const TrigramRecord* const trigram_records = trigrams();
+    const auto trigrams_are_valid = std::all_of(trigram_records, trigram_records + h.trigram_count, [&h](const TrigramRecord& r) { return to_type<uint64_t>(r.first_posting) + r.posting_count <= h.posting_count; });
+    const uint32_t* const posting_records = postings();
+    const auto postings_are_valid = std::all_of(posting_records, posting_records + h.posting_count, [&h](uint32_t i) { return i < h.entry_count; });
+    const DirRecord* const dir_records = dirs();
+    const auto dirs_are_valid = std::all_of(dir_records, dir_records + h.dir_count, [&is_in_chars](const DirRecord& r) { return is_in_chars(r.path_offset, r.path_size); });
+    return entries_are_valid && trigrams_are_valid && postings_are_valid && dirs_are_valid;
+}
+
+const NameIndex::Header& NameIndex::header() const noexcept { return *reinterpret_cast<const Header*>(_data); }
+
+const NameIndex::EntryRecord* NameIndex::entries() const noexcept { return reinterpret_cast<const EntryRecord*>(_data + get_offset(header(), to_int(Section::Entries))); }
+
+const NameIndex::TrigramRecord* NameIndex::trigrams() const noexcept { return reinterpret_cast<const TrigramRecord*>(_data + get_offset(header(), to_int(Section::Trigrams))); }
+
+const uint32_t* NameIndex::postings() const noexcept { return reinterpret_cast<const uint32_t*>(_data + get_offset(header(), to_int(Section::Postings))); }
+
+const NameIndex::DirRecord* NameIndex::dirs() const noexcept { return reinterpret_cast<const DirRecord*>(_data + get_offset(header(), to_int(Section::Dirs))); }
+
+const char16_t* NameIndex::chars() const noexcept { return reinterpret_cast<const char16_t*>(_data + get_offset(header(), to_int(Section::Chars))); }
+
+QStringView NameIndex::to_view(uint32_t offset, uint32_t size) const noexcept { return QStringView(chars() + offset, size); }
+
+const NameIndex::TrigramRecord* NameIndex::find_trigram(uint64_t key) const noexcept {
+    const TrigramRecord* const first = trigrams();
+    const TrigramRecord* const last = first + header().trigram_count;
+    const TrigramRecord* const it = std::lower_bound(first, last, key, [](const TrigramRecord& record, uint64_t key) { return record.key < key; });
+    return it != last && it->key == key ? it : nullptr;
+}
+
+void NameIndex::thaw() {
+    if (_thawed)
+        return;
+
+    _thawed = true;
+    if (_data == nullptr)
+        return;
+
+    const Header& h = header();
+    std::vector<std::vector<Child>> children_by_dir(h.dir_count);
+    const EntryRecord* const entry_records = entries();
+    for (uint32_t i = 0; i < h.entry_count; ++i) {
+        const EntryRecord& r = entry_records[i];
+        children_by_dir[r.dir].push_back(Child{to_view(r.name_offset, r.name_size).toString(), to_view(r.folded_offset, r.folded_size).toString(), r.is_dir != 0});
+    }
+    const DirRecord* const dir_records = dirs();
+    for (uint32_t i = 0; i < h.dir_count; ++i)
+        _dirs[to_view(dir_records[i].path_offset, dir_records[i].path_size).toString()] = std::make_shared<const std::vector<Child>>(std::move(children_by_dir[i]));
+}
+
+void NameIndex::add_change(const QString& path, bool subtree) {
+    Change& change = _changes[path];
+    change.generation = _generation;
+    change.subtree = change.subtree || subtree;
+    mark_stale(path, subtree);
+}
+
+void NameIndex::mark_stale(const QString& path, bool subtree) {
+    if (_data == nullptr)
+        return;
+
+    const DirRecord* const dir_records = dirs();
+    for (uint32_t i = 0, count = header().dir_count; i < count; ++i) {
+        const QStringView dir_path = to_view(dir_records[i].path_offset, dir_records[i].path_size);
+        if (subtree ? dir_path.startsWith(path) : dir_path == path)
+            _stale_dirs[i] = true;
+    }
+}
+
+void NameIndex::start_build() {
+    if (_building || _changes.empty())
+        return;
+
+    _building = true;
+    const auto job = [guard = _guard, dir_map = _dirs, generation = _generation]() {
+        QByteArray image = build_image(dir_map);
+        const std::lock_guard<std::mutex> locker(guard->mutex);
+        if (guard->index == nullptr)
+            return;
+
+        const auto install = [index = guard->index, image = std::move(image), generation]() mutable {
+            index->_building = false;
+            index->install_image(std::move(image), generation);
+            if (!index->_changes.empty())
+                index->_build_timer.start(); // note: The directories, which have been changed during the build, need the next one
+        };
+        QMetaObject::invokeMethod(&guard->index->_receiver, std::move(install), Qt::QueuedConnection);
+    };
+    QThreadPool::globalInstance()->start(job);
+}
+
+void NameIndex::install_image(QByteArray&& image, uint64_t generation) {
+    if (generation <= _image_generation)
+        return; // note: The index has been built synchronously since the job started
+
+    _image = std::move(image);
+    _data = _image.constData();
+    _image_generation = generation;
+    unmap();
+    std::erase_if(_changes, [generation](const auto& pair) { return pair.second.generation <= generation; });
+    _stale_dirs.assign(header().dir_count, false);
+    for (const auto& [path, change] : _changes)
+        mark_stale(path, change.subtree);
+}
+
+QByteArray NameIndex::build_image(const DirMap& dir_map) {
+    struct Entry {
+        QString name;
+        QString folded;
+        uint32_t dir;
+        bool is_dir;
+    };
+    std::vector<Entry> entry_list;
+    std::vector<const QString*> dir_paths;
+    dir_paths.reserve(dir_map.size());
+    size_t char_count = 0;
+    for (const auto& [path, children] : dir_map) {
+        const auto dir = to_type<uint32_t>(dir_paths.size());
+        dir_paths.push_back(&path);
+        char_count += path.size();
+        for (const Child& child : *children) {
+            entry_list.push_back(Entry{child.name, child.folded, dir, child.is_dir});
+            char_count += child.name.size() + entry_list.back().folded.size();
+        }
+    }
+    std::sort(std::begin(entry_list), std::end(entry_list), [](const Entry& lhs, const Entry& rhs) { return lhs.folded != rhs.folded ? lhs.folded < rhs.folded : lhs.name < rhs.name; });
+
+    std::vector<std::pair<uint64_t, uint32_t>> trigram_entry_pairs;
+    for (size_t i = 0, sz = entry_list.size(); i < sz; ++i) {
+        const QString& folded = entry_list[i].folded;
+        const auto* const str = reinterpret_cast<const char16_t*>(folded.constData());
+        for (qsizetype j = 0; j + trigram_size <= folded.size(); ++j)
+            trigram_entry_pairs.emplace_back(to_trigram(str + j), to_type<uint32_t>(i));
+    }
+    std::sort(std::begin(trigram_entry_pairs), std::end(trigram_entry_pairs));
+    trigram_entry_pairs.erase(std::unique(std::begin(trigram_entry_pairs), std::end(trigram_entry_pairs)), std::end(trigram_entry_pairs));
+    size_t trigram_count = 0;
+    for (size_t i = 0, sz = trigram_entry_pairs.size(); i < sz; ++i) {
+        if (i == 0 || trigram_entry_pairs[i].first != trigram_entry_pairs[i - 1].first)
+            ++trigram_count;
+    }
+
+    Header h{};
+    std::memcpy(h.magic, _magic, sizeof(_magic));
+    h.version = _version;
+    h.entry_count = to_type<uint32_t>(entry_list.size());
+    h.trigram_count = to_type<uint32_t>(trigram_count);
+    h.posting_count = to_type<uint32_t>(trigram_entry_pairs.size());
+    h.dir_count = to_type<uint32_t>(dir_paths.size());
+    h.char_count = to_type<uint32_t>(char_count);
+    QByteArray image(get_offset(h, to_int(Section::End)), '\0');
+    char* const data = image.data();
+    std::memcpy(data, &h, sizeof(h));
+
+    auto* const chars_ = reinterpret_cast<char16_t*>(data + get_offset(h, to_int(Section::Chars)));
+    uint32_t char_offset = 0;
+    const auto add_chars = [chars_, &char_offset](const QString& str) {
+        std::memcpy(chars_ + char_offset, str.constData(), str.size() * sizeof(char16_t));
+        const uint32_t offset = char_offset;
+        char_offset += str.size();
+        return offset;
+    };
+    auto* const dir_records = reinterpret_cast<DirRecord*>(data + get_offset(h, to_int(Section::Dirs)));
+    for (size_t i = 0, sz = dir_paths.size(); i < sz; ++i)
+        dir_records[i] = DirRecord{add_chars(*dir_paths[i]), to_type<uint32_t>(dir_paths[i]->size())};
+
+    auto* const entry_records = reinterpret_cast<EntryRecord*>(data + get_offset(h, to_int(Section::Entries)));
+    for (size_t i = 0, sz = entry_list.size(); i < sz; ++i) {
+        const Entry& entry = entry_list[i];
+        const uint32_t name_offset = add_chars(entry.name);
+        const uint32_t folded_offset = add_chars(entry.folded);
+        entry_records[i] = EntryRecord{name_offset, to_type<uint32_t>(entry.name.size()), folded_offset, to_type<uint32_t>(entry.folded.size()), entry.dir, entry.is_dir};
+    }
+    assert(char_offset == char_count);
+
+    auto* const trigram_records = reinterpret_cast<TrigramRecord*>(data + get_offset(h, to_int(Section::Trigrams)));
+    auto* const posting_records = reinterpret_cast<uint32_t*>(data + get_offset(h, to_int(Section::Postings)));
+    size_t trigram_index = 0;
+    for (size_t i = 0, sz = trigram_entry_pairs.size(); i < sz; ++i) {
+        const auto& [key, entry] = trigram_entry_pairs[i];
+        if (i != 0 && key != trigram_records[trigram_index].key)
+            ++trigram_index;
+
+        TrigramRecord& record = trigram_records[trigram_index];
+        if (record.posting_count == 0)
+            record = TrigramRecord{key, to_type<uint32_t>(i), 0};
+
+        ++record.posting_count;
+        posting_records[i] = entry;
+    }
+
+    return image;
+}
+
+void NameIndex::unmap() {
+    if (_mapped != nullptr) {
+        _file.unmap(_mapped);
+        _mapped = nullptr;
+    }
+    _file.close();
+}
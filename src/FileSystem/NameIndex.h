@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QByteArray>
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QStringView>
+#include <QTimer>
+
+class FileSystemObject;
+
+// note: The search runs on the last built image and on the directories changed since then. The image is rebuilt on the thread pool and swapped in, when it's ready,
+//       so a visited listing doesn't make the next search sort and split the whole index into trigrams on the GUI thread.
+class NameIndex {
+public:
+    struct Match {
+        QString path;
+        QString name;
+        bool is_dir;
+    };
+
+    explicit NameIndex(const QString& id);
+    ~NameIndex();
+
+    void update_dir(const QStringView& dir_path, const std::deque<FileSystemObject>& objects);
+    std::vector<Match> search(const QStringView& text, bool case_sensitive, size_t limit);
+    size_t size() const noexcept;
+    bool save();
+
+private:
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t entry_count;
+        uint32_t trigram_count;
+        uint32_t posting_count;
+        uint32_t dir_count;
+        uint32_t char_count;
+        uint32_t reserved;
+    };
+    struct EntryRecord {
+        uint32_t name_offset;
+        uint32_t name_size;
+        uint32_t folded_offset;
+        uint32_t folded_size;
+        uint32_t dir;
+        uint32_t is_dir;
+    };
+    struct TrigramRecord {
+        uint64_t key;
+        uint32_t first_posting;
+        uint32_t posting_count;
+    };
+    struct DirRecord {
+        uint32_t path_offset;
+        uint32_t path_size;
+    };
+    struct Child {
+        QString name;
+        QString folded;
+        bool is_dir;
+    };
+    using DirMap = std::unordered_map<QString, std::shared_ptr<const std::vector<Child>>>; // note: The children are shared with the build job, so its snapshot copies only the map
+    struct Change {
+        uint64_t generation;
+        bool subtree; // note: The directory and its subdirectories have been removed or replaced
+    };
+    struct Guard {
+        std::mutex mutex;
+        NameIndex* index = nullptr;
+    };
+
+    static uint64_t to_trigram(const char16_t* str) noexcept;
+    static QByteArray build_image(const DirMap& dir_map);
+    static size_t align(size_t size) noexcept;
+    static size_t get_offset(const Header& h, int section) noexcept;
+    bool set_image(const char* data, size_t size) noexcept;
+    const Header& header() const noexcept;
+    const EntryRecord* entries() const noexcept;
+    const TrigramRecord* trigrams() const noexcept;
+    const uint32_t* postings() const noexcept;
+    const DirRecord* dirs() const noexcept;
+    const char16_t* chars() const noexcept;
+    QStringView to_view(uint32_t offset, uint32_t size) const noexcept;
+    std::vector<Match> search_image(const QStringView& text, const QString& folded_text, bool case_sensitive, size_t limit) const;
+    const TrigramRecord* find_trigram(uint64_t key) const noexcept;
+    void thaw();
+    void add_change(const QString& path, bool subtree);
+    void mark_stale(const QString& path, bool subtree);
+    void start_build();
+    void install_image(QByteArray&& image, uint64_t generation);
+    void unmap();
+
+private:
+    constexpr static char _magic[4] = {'W', 'D', 'N', 'I'};
+    constexpr static uint32_t _version = 1;
+    constexpr static int _build_delay = 500; // note: In milliseconds
+
+    QFile _file;
+    uchar* _mapped = nullptr;
+    QByteArray _image;
+    const char* _data = nullptr;
+    DirMap _dirs;
+    std::unordered_map<QString, Change> _changes; // note: The directories, which have been changed since the image was built
+    std::vector<bool> _stale_dirs; // note: The directories of the image, whose entries are outdated by the changes
+    uint64_t _generation = 0;
+    uint64_t _image_generation = 0;
+    bool _building = false;
+    bool _thawed = false;
+    bool _modified = false;
+    std::shared_ptr<Guard> _guard;
+    QObject _receiver; // note: The built image is installed through the queued call to this object, so it happens on the thread of the index
+    QTimer _build_timer; // note: The build is delayed until the visited listings settle, so a burst of them copies the directories for the job once
+};
@@ -1,11 +1,11 @@
 #include "CurrentState.h"
 
+#include "../../Logger.h"
 #include "TimeParser.h"
 
-Parser::CurrentState::CurrentState(const QStringView& current_path, TagOrderMap::const_iterator first, Result& result) : _current_path(current_path), _result(result) {
-#ifndef NDEBUG
-    TimeParser::test();
-#endif
+Parser::CurrentState::CurrentState(const QStringView& current_path, TagOrderMap::const_iterator first, Result& result, MatchHandler&& match_handler)
+    : _current_path(current_path), _match_handler(std::move(match_handler)), _result(result)
+{
     stack.push(first);
 }
 
@@ -13,6 +13,7 @@ void Parser::CurrentState::update_if_start_tag(Tag t) {
     switch (t) {
         case Tag::Response:
             _obj = {};
+            _abs_path.clear();
             break;
 
         case Tag::PropStat:
@@ -68,10 +69,16 @@ void Parser::CurrentState::update_if_end_tag(Tag t) {
                 break;
             }
             FileSystemObject obj(std::move(_obj.name), _obj.type.second, std::move(_obj.creation_date), std::move(_obj.last_modified), std::move(_obj.content_length));
-            if (_obj.is_curr_dir_obj)
+            if (_obj.is_curr_dir_obj) {
                 _result.first = std::make_unique<FileSystemObject>(std::move(obj));
-            else
+            } else if (_match_handler) {
+                if (obj.get_type() == FileSystemObject::Type::File)
+                    _abs_path.chop(1);
+
+                _match_handler(std::move(_abs_path), std::move(obj));
+            } else {
                 _result.second.emplace_back(std::move(obj));
+            }
 
             break;
         }
@@ -84,12 +91,12 @@ void Parser::CurrentState::update_if_end_tag(Tag t) {
 void Parser::CurrentState::update_if_data(Tag t, const QStringView& data) {
     switch (t) {
         case Tag::Href: {
-            QString abs_path = QUrl::fromPercentEncoding(data.toLatin1());
-            if (abs_path.back() != '/')
-                abs_path += '/';
+            _abs_path = QUrl::fromPercentEncoding(data.toLatin1());
+            if (_abs_path.back() != '/')
+                _abs_path += '/';
 
-            _obj.is_curr_dir_obj = abs_path == _current_path;
-            _obj.name = FSObjectStruct::extract_name(abs_path);
+            _obj.is_curr_dir_obj = _abs_path == _current_path;
+            _obj.name = FSObjectStruct::extract_name(_abs_path);
             break;
         }
 
@@ -135,5 +142,5 @@ void Parser::CurrentState::update_if_data(Tag t, const QStringView& data) {
 
 void Parser::CurrentState::set_error(QString&& msg) {
     was_error = true;
-    qWarning(qUtf8Printable(QObject::tr("An error has occured during the reply parse: %s.")), qUtf8Printable(msg));
+    Logger::log(QtWarningMsg, QT_TR_NOOP("An error has occured during the reply parse: %1."), std::move(msg));
 }
@@ -10,7 +10,9 @@
 #include "Parser.h"
 
 struct Parser::CurrentState {
-    CurrentState(const QStringView& current_path, TagOrderMap::const_iterator first, Result& result);
+    class TimeParser;
+
+    CurrentState(const QStringView& current_path, TagOrderMap::const_iterator first, Result& result, MatchHandler&& match_handler = MatchHandler());
 
     void update_if_start_tag(Tag t);
     void update_if_end_tag(Tag t);
@@ -18,16 +20,17 @@ struct Parser::CurrentState {
 
     bool was_error = false;
     std::stack<TagOrderMap::const_iterator, std::vector<TagOrderMap::const_iterator>> stack;
-    QStringView not_dav_namespace;
+    QString not_dav_namespace;
+    QString text;
 
 private:
     void set_error(QString&& msg);
 
 private:
-    class TimeParser;
-
-    const QStringView& _current_path;
+    const QStringView _current_path;
+    const MatchHandler _match_handler;
     FSObjectStruct _obj;
+    QString _abs_path;
     FSObjectStruct::Status _status = FSObjectStruct::Status::None;
     Result& _result;
 };
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
@@ -10,6 +11,7 @@
 #include <QByteArray>
 #include <QString>
 #include <QStringView>
+#include <QXmlStreamReader>
 
 #include "../../Util.h"
 
@@ -20,12 +22,12 @@ public:
     using CurrDirObj = std::unique_ptr<FileSystemObject>;
     using Objects = std::deque<FileSystemObject>;
     using Result = std::pair<CurrDirObj, Objects>;
+    using MatchHandler = std::function<void (QString&& abs_path, FileSystemObject&& obj)>;
 
-    static Result parse_propfind_reply(const QStringView& current_path, const QByteArray& data);
+    class SearchReplyParser;
+    struct CurrentState;
 
-#ifndef NDEBUG
-    static void test();
-#endif
+    static Result parse_propfind_reply(const QStringView& current_path, const QByteArray& data);
 
 private:
     enum class Tag {None, Multistatus, Response, PropStat, Prop, Href, ResourceType, CreationDate, GetLastModified, Collection, GetContentLength, Status};
@@ -35,7 +37,8 @@ private:
     };
     using TagSet = std::unordered_set<Tag, TagHasher>;
     using TagOrderMap = std::unordered_map<Tag, TagSet, TagHasher>;
-    struct CurrentState;
+
+    static void read(QXmlStreamReader& reader, CurrentState& state);
 
     static const std::unordered_map<QString, Tag> _propfind_tag_by_str_map;
     static const TagOrderMap _propfind_tag_order;
@@ -0,0 +1,33 @@
+#include "SearchReplyParser.h"
+
+#include "CurrentState.h"
+
+Parser::SearchReplyParser::SearchReplyParser(const QStringView& scope_path, MatchHandler&& handler) : _scope_path(scope_path.toString()) {
+    assert(!_scope_path.isEmpty());
+    assert(_scope_path.back() == '/');
+
+    const auto first = _propfind_tag_order.find(Tag::None);
+    assert(first != std::end(_propfind_tag_order));
+    _state = std::make_unique<CurrentState>(_scope_path, first, _result, std::move(handler));
+}
+
+Parser::SearchReplyParser::~SearchReplyParser() = default;
+
+void Parser::SearchReplyParser::add_data(const QByteArray& data) {
+    _reader.addData(data);
+    read();
+}
+
+void Parser::SearchReplyParser::finish() {
+    if (!_reader.atEnd() || _reader.hasError())
+        throw std::runtime_error("invalid XML format");
+
+    if (_state->was_error)
+        qWarning().noquote() << QObject::tr("The search reply has contained invalid entries");
+}
+
+void Parser::SearchReplyParser::read() {
+    Parser::read(_reader, *_state);
+    if (_reader.error() != QXmlStreamReader::NoError && _reader.error() != QXmlStreamReader::PrematureEndOfDocumentError) // note: The rest of the reply hasn't been received yet
+        throw std::runtime_error("invalid XML format");
+}
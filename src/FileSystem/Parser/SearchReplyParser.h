@@ -0,0 +1,27 @@
+#pragma once
+
+#include <memory>
+
+#include <QByteArray>
+#include <QString>
+#include <QXmlStreamReader>
+
+#include "Parser.h"
+
+class Parser::SearchReplyParser {
+public:
+    SearchReplyParser(const QStringView& scope_path, MatchHandler&& handler);
+    ~SearchReplyParser();
+
+    void add_data(const QByteArray& data);
+    void finish();
+
+private:
+    void read();
+
+private:
+    const QString _scope_path;
+    Result _result;
+    QXmlStreamReader _reader;
+    std::unique_ptr<CurrentState> _state;
+};
@@ -17,10 +17,6 @@ public:
 
     static std::chrono::sys_seconds to_sys_seconds(const QStringView& str, Format f);
 
-#ifndef NDEBUG
-    static void test();
-#endif
-
 private:
     struct CustomTime {
         std::chrono::year year;
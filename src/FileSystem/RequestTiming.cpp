@@ -0,0 +1,65 @@
+#include "RequestTiming.h"
+
+#include "../Metrics.h"
+#include "../Trace.h"
+
+namespace {
+    QString to_ms(int64_t us) { return us < 0 ? QStringLiteral("-") : QString::number(us / 1000.0, 'f', 1); }
+}
+
+void RequestTiming::start() {
+    timer.start();
+    trace_start = Trace::start();
+}
+
+int64_t RequestTiming::get_elapsed() const noexcept { return timer.nsecsElapsed() / 1000; }
+
+QString RequestTiming::to_string() const {
+    QString text = QObject::tr("queued %1 ms, connect %2 ms, waiting %3 ms, transfer %4 ms, parse %5 ms").arg(to_ms(get_duration(0)), to_ms(get_duration(1)), to_ms(get_duration(2)), to_ms(get_duration(3)), to_ms(get_duration(4)));
+    text += QObject::tr("; %1 bytes, %2, %3").arg(QString::number(bytes), connecting < 0 ? QObject::tr("reused connection") : QObject::tr("new connection"), http2 ? QStringLiteral("HTTP/2") : QStringLiteral("HTTP/1.1"));
+    return text;
+}
+
+void RequestTiming::publish(const QString& server) const {
+    static const auto metrics = Metrics::get_instance();
+    for (int i = 0; i < phase_count; ++i) {
+        const int64_t duration = get_duration(i);
+        if (duration < 0)
+            continue;
+
+        const Phase phase = get_phase(i);
+        metrics->get_histogram(QStringLiteral("client.propfind_%1_us{%2}").arg(QLatin1StringView(phase.metric_name), server)).record(duration);
+        if (trace_start >= 0)
+            Trace::add(phase.trace_name, trace_start + phase.begin, duration);
+    }
+    static Metrics::Counter& new_connections = metrics->get_counter(QStringLiteral("client.connections_new"));
+    static Metrics::Counter& reused_connections = metrics->get_counter(QStringLiteral("client.connections_reused"));
+    (connecting < 0 ? reused_connections : new_connections).add();
+}
+
+const char* RequestTiming::get_phase_name(int index) const noexcept { return get_phase(index).metric_name; }
+
+int64_t RequestTiming::get_duration(int index) const noexcept {
+    const Phase phase = get_phase(index);
+    return phase.begin < 0 || phase.end < phase.begin ? -1 : phase.end - phase.begin;
+}
+
+RequestTiming::Phase RequestTiming::get_phase(int index) const noexcept {
+    const int64_t connected = request_sent >= 0 ? request_sent : encrypted; // note: There is no signal between the TCP handshake and sending, so the sending is a part of the connection phase
+    switch (index) {
+        case 0:
+            return Phase{"PROPFIND: queued", "queued", 0, connecting >= 0 ? connecting : request_sent};
+
+        case 1:
+            return Phase{"PROPFIND: connect", "connect", connecting, connecting >= 0 ? connected : -1};
+
+        case 2:
+            return Phase{"PROPFIND: waiting", "waiting", request_sent, first_byte};
+
+        case 3:
+            return Phase{"PROPFIND: transfer", "transfer", first_byte, last_byte};
+
+        default:
+            return Phase{"PROPFIND: parse", "parse", last_byte, parse_done};
+    }
+}
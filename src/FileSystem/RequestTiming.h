@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+#include <QElapsedTimer>
+#include <QString>
+
+// note: The time points are in microseconds since the request was passed to the access manager, -1 means the point hasn't been reached.
+//       QNetworkReply doesn't report the host lookup, so the DNS time is a part of the connection phase together with the TCP and TLS handshakes.
+struct RequestTiming {
+    constexpr static int phase_count = 5;
+
+    void start();
+    int64_t get_elapsed() const noexcept;
+    QString to_string() const;
+    void publish(const QString& server) const;
+    const char* get_phase_name(int index) const noexcept;
+    int64_t get_duration(int index) const noexcept;
+
+    QElapsedTimer timer;
+    int64_t trace_start = -1;
+    int64_t connecting = -1; // note: It isn't reached, if the access manager reuses a connection
+    int64_t encrypted = -1;
+    int64_t request_sent = -1;
+    int64_t first_byte = -1;
+    int64_t last_byte = -1;
+    int64_t parse_done = -1;
+    int64_t bytes = 0;
+    bool http2 = false;
+
+private:
+    struct Phase {
+        const char* trace_name;
+        const char* metric_name;
+        int64_t begin;
+        int64_t end;
+    };
+
+    Phase get_phase(int index) const noexcept;
+};
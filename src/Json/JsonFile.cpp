@@ -1,10 +1,9 @@
 #include "JsonFile.h"
 
+#include "../Util.h"
+
 JsonFile::JsonFile(const QString& filename) {
-    QString path = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation);
-#ifndef Q_OS_ANDROID
-    path += "/WebDAVClient_2212ca02-1a86-4707-b731-492959a8fd40";
-#endif
+    const QString path = get_config_path();
     QDir dir;
     qDebug(qUtf8Printable(QObject::tr("Settings path: \"%s\"")), qUtf8Printable(path));
     if (!dir.mkpath(path)) {
@@ -1,5 +1,6 @@
 #include "SettingsJsonFile.h"
 
+#include "../LogFileSink.h"
 #include "../Logger.h"
 #include "../Qml/Sort/SortParam.h"
 #include "../Qml/FileItemModel/Role.h"
@@ -11,18 +12,26 @@ namespace Qml {
 
 const char* const SettingsJsonFile::_dl_path_key = "download_path";
 const char* const SettingsJsonFile::_log_level_key = "log_level";
+const char* const SettingsJsonFile::_log_max_count_key = "log_max_message_count";
+const char* const SettingsJsonFile::_log_max_size_key = "log_max_size_kib";
+const char* const SettingsJsonFile::_log_file_key = "log_file";
+const char* const SettingsJsonFile::_log_file_size_key = "log_file_max_size_kib";
+const char* const SettingsJsonFile::_log_file_count_key = "log_file_count";
+const char* const SettingsJsonFile::_log_compression_key = "log_file_compression";
 const char* const SettingsJsonFile::_sort_param_array_key = "sort";
 const char* const SettingsJsonFile::_sort_param_id_key = "id";
 const char* const SettingsJsonFile::_sort_param_desc_key = "descending";
+const char* const SettingsJsonFile::_natural_key = "natural_sort";
 const char* const SettingsJsonFile::_cs_key = "case_sensitive";
+const char* const SettingsJsonFile::_fuzzy_key = "fuzzy_search";
 
 const std::unordered_map<QString, Qml::SortParam> SettingsJsonFile::_supported_sort_params{
-    {QStringLiteral("type"),              {Qml::Role::FileFlag,     QObject::tr("Type (directories are higher)"), false, Qml::SortParam::compare_file_flag}},
-    {QStringLiteral("name"),              {Qml::Role::Name,         QObject::tr("Name"),                          false, Qml::SortParam::compare_qstring}},
-    {QStringLiteral("modification_time"), {Qml::Role::ModTime,      QObject::tr("Modification time"),             false, Qml::SortParam::compare_time_t}},
-    {QStringLiteral("creation_time"),     {Qml::Role::CreationTime, QObject::tr("Creation time"),                 false, Qml::SortParam::compare_time_t}},
-    {QStringLiteral("size"),              {Qml::Role::Size,         QObject::tr("Size"),                          false, Qml::SortParam::compare_uint64_t}},
-    {QStringLiteral("extension"),         {Qml::Role::Extension,    QObject::tr("Filename extension"),            false, Qml::SortParam::compare_extension}}
+    {QStringLiteral("type"),              {Qml::Role::FileFlag,     QObject::tr("Type (directories are higher)"), false}},
+    {QStringLiteral("name"),              {Qml::Role::Name,         QObject::tr("Name"),                          false}},
+    {QStringLiteral("modification_time"), {Qml::Role::ModTime,      QObject::tr("Modification time"),             false}},
+    {QStringLiteral("creation_time"),     {Qml::Role::CreationTime, QObject::tr("Creation time"),                 false}},
+    {QStringLiteral("size"),              {Qml::Role::Size,         QObject::tr("Size"),                          false}},
+    {QStringLiteral("extension"),         {Qml::Role::Extension,    QObject::tr("Filename extension"),            false}}
 };
 
 const std::vector<QString> SettingsJsonFile::_default_sort_param_order{QStringLiteral("type"), QStringLiteral("name"), QStringLiteral("modification_time"), QStringLiteral("creation_time"), QStringLiteral("size"), QStringLiteral("extension")};
@@ -61,6 +70,76 @@ SettingsJsonFile::SettingsJsonFile(std::shared_ptr<Logger> logger) : JsonFile("c
     if (!ok)
         obj[_log_level_key] = _log_level;
 
+    it = obj.find(_log_max_count_key);
+    exists = it != std::end(obj);
+    ok = exists && it->isDouble() && it->toInt() > 0;
+    all_is_ok &= ok;
+    if (exists && !ok)
+        json_value_type_warning(_log_max_count_key, QObject::tr("a positive number"));
+
+    _log_max_count = ok ? it->toInt() : 10'000;
+    if (!ok)
+        obj[_log_max_count_key] = _log_max_count;
+
+    it = obj.find(_log_max_size_key);
+    exists = it != std::end(obj);
+    ok = exists && it->isDouble() && it->toInt() > 0;
+    all_is_ok &= ok;
+    if (exists && !ok)
+        json_value_type_warning(_log_max_size_key, QObject::tr("a positive number"));
+
+    _log_max_size = ok ? it->toInt() : 4096;
+    if (!ok)
+        obj[_log_max_size_key] = _log_max_size;
+
+    _logger->set_retention(_log_max_count, size_t(_log_max_size) * 1024);
+
+    it = obj.find(_log_file_key);
+    exists = it != std::end(obj);
+    ok = exists && it->isBool();
+    all_is_ok &= ok;
+    if (exists && !ok)
+        json_value_type_warning(_log_file_key, QObject::tr("a boolean value"));
+
+    _log_file = ok ? it->toBool() : false;
+    if (!ok)
+        obj[_log_file_key] = _log_file;
+
+    it = obj.find(_log_file_size_key);
+    exists = it != std::end(obj);
+    ok = exists && it->isDouble() && it->toInt() > 0;
+    all_is_ok &= ok;
+    if (exists && !ok)
+        json_value_type_warning(_log_file_size_key, QObject::tr("a positive number"));
+
+    _log_file_size = ok ? it->toInt() : 1024;
+    if (!ok)
+        obj[_log_file_size_key] = _log_file_size;
+
+    it = obj.find(_log_file_count_key);
+    exists = it != std::end(obj);
+    ok = exists && it->isDouble() && it->toInt() > 0;
+    all_is_ok &= ok;
+    if (exists && !ok)
+        json_value_type_warning(_log_file_count_key, QObject::tr("a positive number"));
+
+    _log_file_count = ok ? it->toInt() : 5;
+    if (!ok)
+        obj[_log_file_count_key] = _log_file_count;
+
+    it = obj.find(_log_compression_key);
+    exists = it != std::end(obj);
+    ok = exists && it->isBool();
+    all_is_ok &= ok;
+    if (exists && !ok)
+        json_value_type_warning(_log_compression_key, QObject::tr("a boolean value"));
+
+    _log_compression = ok ? it->toBool() : true;
+    if (!ok)
+        obj[_log_compression_key] = _log_compression;
+
+    update_log_file_sink();
+
     _sort_params.reserve(_supported_sort_params.size());
     it = obj.find(_sort_param_array_key);
     exists = it != std::end(obj);
@@ -74,6 +153,17 @@ SettingsJsonFile::SettingsJsonFile(std::shared_ptr<Logger> logger) : JsonFile("c
         obj[_sort_param_array_key] = to_json_array(_sort_params);
     }
 
+    it = obj.find(_natural_key);
+    exists = it != std::end(obj);
+    ok = exists && it->isBool();
+    all_is_ok &= ok;
+    if (exists && !ok)
+        json_value_type_warning(_natural_key, QObject::tr("a boolean value"));
+
+    _natural = ok ? it->toBool() : false;
+    if (!ok)
+        obj[_natural_key] = _natural;
+
     it = obj.find(_cs_key);
     exists = it != std::end(obj);
     ok = exists && it->isBool();
@@ -85,6 +175,17 @@ SettingsJsonFile::SettingsJsonFile(std::shared_ptr<Logger> logger) : JsonFile("c
     if (!ok)
         obj[_cs_key] = _case_sensitive;
 
+    it = obj.find(_fuzzy_key);
+    exists = it != std::end(obj);
+    ok = exists && it->isBool();
+    all_is_ok &= ok;
+    if (exists && !ok)
+        json_value_type_warning(_fuzzy_key, QObject::tr("a boolean value"));
+
+    _fuzzy = ok ? it->toBool() : false;
+    if (!ok)
+        obj[_fuzzy_key] = _fuzzy;
+
     if (!all_is_ok)
         set_root_obj(std::move(obj));
 }
@@ -110,18 +211,70 @@ void SettingsJsonFile::set_max_log_level(QtMsgType level) {
     set_value(_log_level_key, std::remove_reference_t<QtMsgType>(_log_level));
 }
 
+int SettingsJsonFile::get_log_max_count() const noexcept { return _log_max_count; }
+
+void SettingsJsonFile::set_log_max_count(int count) {
+    if (_log_max_count == count)
+        return;
+
+    _log_max_count = count;
+    _logger->set_retention(_log_max_count, size_t(_log_max_size) * 1024);
+    set_value(_log_max_count_key, std::remove_reference_t<int>(_log_max_count));
+}
+
+int SettingsJsonFile::get_log_max_size() const noexcept { return _log_max_size; }
+
+void SettingsJsonFile::set_log_max_size(int kib) {
+    if (_log_max_size == kib)
+        return;
+
+    _log_max_size = kib;
+    _logger->set_retention(_log_max_count, size_t(_log_max_size) * 1024);
+    set_value(_log_max_size_key, std::remove_reference_t<int>(_log_max_size));
+}
+
+bool SettingsJsonFile::get_log_file_flag() const noexcept { return _log_file; }
+
+void SettingsJsonFile::set_log_file_flag(bool enabled) {
+    if (_log_file == enabled)
+        return;
+
+    _log_file = enabled;
+    update_log_file_sink();
+    set_value(_log_file_key, std::remove_reference_t<bool>(_log_file));
+}
+
+bool SettingsJsonFile::get_log_compression_flag() const noexcept { return _log_compression; }
+
+void SettingsJsonFile::set_log_compression_flag(bool compress) {
+    if (_log_compression == compress)
+        return;
+
+    _log_compression = compress;
+    update_log_file_sink();
+    set_value(_log_compression_key, std::remove_reference_t<bool>(_log_compression));
+}
+
 std::vector<Qml::SortParam> SettingsJsonFile::get_sort_params() const { return _sort_params; }
 
-void SettingsJsonFile::set_sort_params(const std::vector<Qml::SortParam>& params) {
-    if (_sort_params == params)
+void SettingsJsonFile::set_sort_params(const std::vector<Qml::SortParam>& params, bool natural) {
+    if (_sort_params == params && _natural == natural)
         return;
 
-    _sort_params = params;
-    set_value(_sort_param_array_key, to_json_array(_sort_params));
-    if (_sort_param_changed_signal)
+    if (_sort_params != params) {
+        _sort_params = params;
+        set_value(_sort_param_array_key, to_json_array(_sort_params));
+    }
+    if (_natural != natural) {
+        _natural = natural;
+        set_value(_natural_key, std::remove_reference_t<bool>(_natural));
+    }
+    if (_sort_param_changed_signal) // note: Both values are stored before the notification, so the listing is sorted once
         _sort_param_changed_signal();
 }
 
+bool SettingsJsonFile::get_natural_sort_flag() const noexcept { return _natural; }
+
 bool SettingsJsonFile::get_search_cs_flag() const noexcept { return _case_sensitive; }
 
 void SettingsJsonFile::set_search_cs_flag(bool case_sensitive) {
@@ -132,6 +285,16 @@ void SettingsJsonFile::set_search_cs_flag(bool case_sensitive) {
     set_value(_cs_key, std::remove_reference_t<bool>(_case_sensitive));
 }
 
+bool SettingsJsonFile::get_search_fuzzy_flag() const noexcept { return _fuzzy; }
+
+void SettingsJsonFile::set_search_fuzzy_flag(bool fuzzy) {
+    if (_fuzzy == fuzzy)
+        return;
+
+    _fuzzy = fuzzy;
+    set_value(_fuzzy_key, std::remove_reference_t<bool>(_fuzzy));
+}
+
 void SettingsJsonFile::set_notification_func(std::function<void ()>&& func) noexcept { _sort_param_changed_signal = std::move(func); }
 
 SettingsJsonFile::SortParamVector SettingsJsonFile::get_default_sort_params() {
@@ -145,6 +308,13 @@ SettingsJsonFile::SortParamVector SettingsJsonFile::get_default_sort_params() {
     return result;
 }
 
+void SettingsJsonFile::update_log_file_sink() {
+    if (_log_file)
+        _logger->set_file_sink(std::make_unique<LogFileSink>(get_config_path() + QStringLiteral("/logs"), int64_t(_log_file_size) * 1024, _log_file_count, _log_compression));
+    else
+        _logger->set_file_sink(nullptr);
+}
+
 bool SettingsJsonFile::read_sort_params(const QJsonArray& array) {
     for (auto it = std::begin(array), end = std::end(array); it != end; ++it) {
         const QJsonValue& val = *it;
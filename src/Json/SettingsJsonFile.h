@@ -28,16 +28,28 @@ public:
     void set_download_path(const QStringView& path);
     QtMsgType get_max_log_level() const noexcept;
     void set_max_log_level(QtMsgType level);
+    int get_log_max_count() const noexcept;
+    void set_log_max_count(int count);
+    int get_log_max_size() const noexcept;
+    void set_log_max_size(int kib);
+    bool get_log_file_flag() const noexcept;
+    void set_log_file_flag(bool enabled);
+    bool get_log_compression_flag() const noexcept;
+    void set_log_compression_flag(bool compress);
     std::vector<Qml::SortParam> get_sort_params() const;
-    void set_sort_params(const std::vector<Qml::SortParam>& params);
+    void set_sort_params(const std::vector<Qml::SortParam>& params, bool natural);
+    bool get_natural_sort_flag() const noexcept;
     bool get_search_cs_flag() const noexcept;
     void set_search_cs_flag(bool case_sensitive);
+    bool get_search_fuzzy_flag() const noexcept;
+    void set_search_fuzzy_flag(bool fuzzy);
     void set_notification_func(std::function<void ()>&& func) noexcept;
 
 private:
     using SortParamVector = std::vector<Qml::SortParam>;
 
     static SortParamVector get_default_sort_params();
+    void update_log_file_sink();
     bool read_sort_params(const QJsonArray& array);
     static QJsonArray to_json_array(const SortParamVector& params);
     template <typename T>
@@ -46,17 +58,33 @@ private:
 private:
     static const char* const _dl_path_key;
     static const char* const _log_level_key;
+    static const char* const _log_max_count_key;
+    static const char* const _log_max_size_key;
+    static const char* const _log_file_key;
+    static const char* const _log_file_size_key;
+    static const char* const _log_file_count_key;
+    static const char* const _log_compression_key;
     static const char* const _sort_param_array_key;
     static const char* const _sort_param_id_key;
     static const char* const _sort_param_desc_key;
+    static const char* const _natural_key;
     static const char* const _cs_key;
+    static const char* const _fuzzy_key;
     static const std::unordered_map<QString, Qml::SortParam> _supported_sort_params;
     static const std::vector<QString> _default_sort_param_order;
     static std::unordered_map<Qml::FileItemModelRole, QString> _sort_param_json_id_by_role_map;
     std::shared_ptr<Logger> _logger;
     QString _download_path;
     QtMsgType _log_level;
+    int _log_max_count;
+    int _log_max_size;
+    bool _log_file;
+    int _log_file_size;
+    int _log_file_count;
+    bool _log_compression;
     SortParamVector _sort_params;
+    bool _natural;
     bool _case_sensitive;
+    bool _fuzzy;
     std::function<void ()> _sort_param_changed_signal;
 };
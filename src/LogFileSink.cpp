@@ -0,0 +1,165 @@
+#include "LogFileSink.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QSaveFile>
+
+#include "Util.h"
+
+namespace {
+    char to_char(QtMsgType type) {
+        switch (type) {
+            case QtDebugMsg:
+                return 'D';
+
+            case QtInfoMsg:
+                return 'I';
+
+            case QtWarningMsg:
+                return 'W';
+
+            case QtCriticalMsg:
+                return 'C';
+
+            case QtFatalMsg:
+                return 'F';
+        }
+        return '?';
+    }
+}
+
+LogFileSink::LogFileSink(const QString& dir_path, int64_t max_file_size, int file_count, bool compress)
+    : _path(dir_path + QStringLiteral("/web_dav_client.log")), _max_file_size(max_file_size), _file_count(file_count), _compress(compress)
+{
+    if (!QDir().mkpath(dir_path))
+        Logger::log(QtCriticalMsg, QT_TR_NOOP("Could not create directory \"%1\""), dir_path);
+
+    _file.setFileName(_path);
+    if (!_file.open(QIODeviceBase::Append | QIODeviceBase::Unbuffered)) // note: The writer thread buffers a batch itself, so every batch reaches the system at once and survives a crash of the application
+        Logger::log(QtCriticalMsg, QT_TR_NOOP("Could not open file \"%1\""), _path);
+
+    _thread = std::thread(&LogFileSink::run, this);
+}
+
+LogFileSink::~LogFileSink() {
+    {
+        const std::lock_guard<std::mutex> locker(_mutex);
+        _stopped = true;
+    }
+    _condition.notify_one();
+    _thread.join();
+}
+
+void LogFileSink::append(const std::vector<Logger::Message>& messages) {
+    if (messages.empty())
+        return;
+
+    bool notify;
+    {
+        const std::lock_guard<std::mutex> locker(_mutex);
+        const size_t size = _pending.size();
+        std::copy_if(std::begin(messages), std::end(messages), std::back_inserter(_pending), [](const Logger::Message& msg) { return !msg.queued; }); // note: The arguments are implicitly shared, so the copies are cheap
+        _appended_count += _pending.size() - size;
+        notify = _pending.size() >= _batch_size;
+    }
+    if (notify)
+        _condition.notify_one();
+}
+
+void LogFileSink::append_urgent(const Logger::Message& msg) {
+    {
+        const std::lock_guard<std::mutex> locker(_mutex);
+        _pending.push_back(msg);
+        ++_appended_count;
+        _urgent = true;
+    }
+    _condition.notify_one();
+}
+
+void LogFileSink::flush() {
+    if (std::this_thread::get_id() == _thread.get_id())
+        return;
+
+    std::unique_lock<std::mutex> locker(_mutex);
+    const uint64_t count = _appended_count;
+    _urgent = true;
+    _condition.notify_one();
+    _written_condition.wait_for(locker, _flush_interval, [this, count]() { return _stopped || _written_count >= count; });
+}
+
+QByteArray LogFileSink::to_line(const Logger::Message& msg) {
+    QByteArray line = QDateTime::fromMSecsSinceEpoch(msg.time).toString(Qt::ISODateWithMs).toUtf8();
+    line += ' ';
+    line += to_char(msg.type);
+    line += ' ';
+    line += Logger::render(msg).toUtf8();
+    line += '\n';
+    return line;
+}
+
+QString LogFileSink::get_segment_path(int index) const { return _path + '.' + QString::number(index) + (_compress ? QStringLiteral(".gz") : QString()); }
+
+void LogFileSink::run() {
+    std::vector<Logger::Message> messages;
+    bool stopped = false;
+    while (!stopped) {
+        {
+            std::unique_lock<std::mutex> locker(_mutex);
+            _condition.wait_for(locker, _flush_interval, [this]() { return _stopped || _urgent || _pending.size() >= _batch_size; });
+            stopped = _stopped;
+            _urgent = false;
+            messages.swap(_pending);
+        }
+        if (messages.empty())
+            continue;
+
+        QByteArray data;
+        for (const Logger::Message& msg : messages)
+            data += to_line(msg); // note: The messages are rendered in the writer thread, so neither the producers nor the main thread wait for the formatting
+
+        write(data); // note: The file is unbuffered, so the batch reaches the system, before the waiting producer of a fatal message continues
+        {
+            const std::lock_guard<std::mutex> locker(_mutex);
+            _written_count += messages.size();
+        }
+        _written_condition.notify_all();
+        messages.clear();
+    }
+}
+
+void LogFileSink::write(const QByteArray& data) {
+    if (!_file.isOpen())
+        return;
+
+    if (_file.size() + data.size() > _max_file_size && _file.size() != 0)
+        rotate();
+
+    _file.write(data);
+}
+
+void LogFileSink::rotate() {
+    _file.close();
+    QFile::remove(get_segment_path(_file_count - 1));
+    for (int i = _file_count - 2; i >= 1; --i)
+        QFile::rename(get_segment_path(i), get_segment_path(i + 1));
+
+    if (_file_count > 1) {
+        if (_compress) {
+            if (_file.open(QIODeviceBase::ReadOnly)) {
+                const QByteArray data = to_gzip(_file.readAll()); // note: The segment can be read with gzip or zcat
+                _file.close();
+                QSaveFile segment(get_segment_path(1));
+                if (segment.open(QIODeviceBase::WriteOnly)) {
+                    segment.write(data);
+                    segment.commit();
+                }
+            }
+            QFile::remove(_path);
+        } else {
+            QFile::rename(_path, get_segment_path(1));
+        }
+    } else {
+        QFile::remove(_path);
+    }
+    _file.open(QIODeviceBase::Append | QIODeviceBase::Unbuffered);
+}
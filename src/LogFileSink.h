@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include "Logger.h"
+
+class LogFileSink {
+public:
+    LogFileSink(const QString& dir_path, int64_t max_file_size, int file_count, bool compress);
+    ~LogFileSink();
+
+    LogFileSink(const LogFileSink&) = delete;
+    LogFileSink& operator=(const LogFileSink&) = delete;
+
+    void append(const std::vector<Logger::Message>& messages);
+    void append_urgent(const Logger::Message& msg);
+    void flush();
+
+private:
+    static QByteArray to_line(const Logger::Message& msg);
+    QString get_segment_path(int index) const;
+    void run();
+    void write(const QByteArray& data);
+    void rotate();
+
+private:
+    constexpr static auto _flush_interval = std::chrono::seconds(1);
+    constexpr static size_t _batch_size = 256;
+
+    const QString _path;
+    const int64_t _max_file_size;
+    const int _file_count;
+    const bool _compress;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::condition_variable _written_condition;
+    std::vector<Logger::Message> _pending; // note: The main thread appends the messages under the mutex, the writer thread takes them all at once
+    uint64_t _appended_count = 0;
+    uint64_t _written_count = 0;
+    bool _urgent = false; // note: The writer thread writes the pending messages without waiting for a full batch
+    bool _stopped = false;
+    QFile _file; // note: Is accessed only by the writer thread
+    std::thread _thread;
+};
@@ -1,5 +1,7 @@
 #include "Logger.h"
 
+#include "LogFileSink.h"
+#include "Metrics.h"
 #include "Util.h"
 
 namespace {
@@ -11,23 +13,25 @@ namespace {
     }
 
     bool operator>=(QtMsgType lhs, QtMsgType rhs) { return lhs == rhs || lhs > rhs; }
-
-    bool operator<(QtMsgType lhs, QtMsgType rhs) { return !(lhs >= rhs); }
 }
 
 #ifndef NDEBUG
 QtMessageHandler Logger::_default_handler = nullptr;
 #endif
 
-Logger::Logger() = default;
+Logger::Logger() : _ring(_ring_capacity) {}
+
+Logger::~Logger() = default;
 
 void Logger::message_handler(QtMsgType type, const QMessageLogContext& context, const QString& msg) {
 #ifndef NDEBUG
     _default_handler(type, context, msg);
 #endif
     static auto logger = Logger::get_instance();
-    if (type >= logger->get_max_level())
-        logger->append_message(std::make_pair(type, msg));
+    if (!logger->is_enabled(type))
+        return;
+
+    logger->append_message(Message{type, QDateTime::currentMSecsSinceEpoch(), nullptr, {msg}});
 }
 
 std::shared_ptr<Logger> Logger::get_instance() {
@@ -40,6 +44,26 @@ std::shared_ptr<Logger> Logger::get_instance() {
 #endif
 }
 
+QString Logger::render(const Message& msg) {
+    if (msg.format == nullptr)
+        return msg.args.value(0).toString();
+
+    const QString format = QObject::tr(msg.format);
+    QString text;
+    text.reserve(format.size());
+    for (qsizetype i = 0, size = format.size(); i < size; ++i) { // note: The placeholders are replaced in a single pass, so a "%1" inside an argument isn't replaced again
+        const qsizetype index = i + 1 < size && format[i] == '%' ? format[i + 1].digitValue() - 1 : -1;
+        if (index < 0 || index >= msg.args.size()) {
+            text += format[i];
+            continue;
+        }
+        const QVariant& arg = msg.args[index];
+        text += arg.typeId() == QMetaType::QByteArray ? QString::fromUtf8(arg.toByteArray()) : arg.toString();
+        ++i;
+    }
+    return text;
+}
+
 void Logger::install_handler() {
 #ifndef NDEBUG
     _default_handler = qInstallMessageHandler(&Logger::message_handler);
@@ -50,42 +74,200 @@ void Logger::install_handler() {
 
 QtMsgType Logger::get_max_level() const noexcept { return _max_level.load(std::memory_order::relaxed); }
 
-void Logger::set_max_level(QtMsgType level) {
-    const auto old = _max_level.load(std::memory_order::relaxed);
-    if (old == level)
-        return;
+bool Logger::is_enabled(QtMsgType type) const noexcept { return type >= get_max_level(); }
 
+void Logger::set_max_level(QtMsgType level) {
     _max_level.store(level, std::memory_order::relaxed);
-    if (_filtered || old > level)
+    const size_t rank = to_rank(level);
+    if (_view_rank == rank)
         return;
 
+    // note: Only the messages of the lower levels, which were captured before the level was raised, stay in the log and are shown again, when the level is lowered back. The messages below the level aren't captured meanwhile, so their arguments are neither converted nor copied and a burst of debug messages can't push the warnings out of the bounded log.
+    notify(Event::AboutToReset, 0);
+    _view_rank = rank;
+    notify(Event::Reset, 0);
+}
+
+size_t Logger::get_message_count() const noexcept { return _view_rank == 0 ? _log.size() : _level_indices[_view_rank - 1].size(); }
+
+const Logger::Message& Logger::get_message(size_t row) const { return _view_rank == 0 ? _log[row] : _log[_level_indices[_view_rank - 1][row] - _removed_count]; }
+
+size_t Logger::get_log_size() const noexcept { return _size; }
+
+void Logger::set_retention(size_t max_count, size_t max_size) {
+    _max_count = max_count;
+    _max_size = max_size;
+    size_t count = 0;
+    for (size_t size = _size; count < _log.size() && (_log.size() - count > _max_count || size > _max_size); ++count)
+        size -= get_size(_log[count]);
+
+    if (count != 0)
+        remove_front(count);
+}
+
+void Logger::append_message(Message&& msg) {
+    if (is_urgent(msg.type)) {
+        const std::lock_guard<std::mutex> locker(_sink_mutex);
+        if (_urgent_sink != nullptr) {
+            _urgent_sink->append_urgent(msg);
+            if (msg.type == QtFatalMsg)
+                _urgent_sink->flush(); // note: The application aborts, when the message handler returns, so the writer thread has to write the message before
+            msg.queued = true;
+        }
+    }
+    if (!_ring.try_push(std::move(msg)))
+        _dropped_count.fetch_add(1, std::memory_order::relaxed);
+}
+
+void Logger::collect() {
+    Message msg;
+    while (_ring.try_pop(msg)) {
+        if (is_enabled(msg.type)) // note: The value of _max_level may change in the main thread after message_handler() has checked it in another thread
+            _new_messages.push_back(std::move(msg));
+    }
+    const uint64_t dropped_count = get_dropped_count();
+    if (dropped_count != _reported_dropped_count) {
+        Message warning{QtWarningMsg, QDateTime::currentMSecsSinceEpoch(), QT_TR_NOOP("%1 log messages were dropped, because the log buffer was full"), {QVariant::fromValue(dropped_count - _reported_dropped_count)}};
+        if (_sink) {
+            _sink->append_urgent(warning);
+            warning.queued = true;
+        }
+        _new_messages.push_back(std::move(warning));
+        _reported_dropped_count = dropped_count;
+        static Metrics::Gauge& gauge = Metrics::get_instance()->get_gauge(QStringLiteral("log.dropped_messages"));
+        gauge.set(dropped_count);
+    }
+    if (_sink)
+        _sink->append(_new_messages);
+
+    append(_new_messages);
+    _new_messages.clear();
+}
+
+uint64_t Logger::get_dropped_count() const noexcept { return _dropped_count.load(std::memory_order::relaxed); }
+
+void Logger::set_notification_func(NotificationFunc&& func) { _notification_func = std::move(func); }
+
+void Logger::set_file_sink(std::unique_ptr<LogFileSink>&& sink) {
+    collect(); // note: The collected messages go to the previous sink
+    std::unique_ptr<LogFileSink> prev_sink; // note: Is destroyed outside the lock, because its destructor waits for the writer thread
     {
-        const std::lock_guard<std::mutex> locker(_mutex);
-        const auto end = std::end(_log);
-        const auto it = std::remove_if(std::begin(_log), end, [level](const std::pair<QtMsgType, QString>& pair) { return pair.first < level; });
-        _log.erase(it, end);
+        const std::lock_guard<std::mutex> locker(_sink_mutex);
+        prev_sink = std::move(_sink);
+        _sink = std::move(sink);
+        _urgent_sink = _sink.get();
     }
-    _filtered = true;
 }
 
-Logger::Log Logger::get_log() {
-    const std::lock_guard<std::mutex> locker(_mutex);
-    _enable_func = _notification_func != nullptr;
-    return _log;
+void Logger::write(Message&& msg) {
+#ifndef NDEBUG
+    if (_default_handler != nullptr)
+        _default_handler(msg.type, QMessageLogContext(), render(msg));
+#endif
+    append_message(std::move(msg));
 }
 
-void Logger::append_message(Message&& msg) {
-    const std::lock_guard<std::mutex> locker(_mutex);
-    if (msg.first < get_max_level()) // note: The value of _max_level may change in the main thread between calls get_max_level() and append_msg() in message_handler() in another thread
+size_t Logger::get_size(const Message& msg) noexcept {
+    size_t size = sizeof(Message);
+    for (const QVariant& arg : msg.args) {
+        switch (arg.typeId()) {
+            case QMetaType::QByteArray:
+                size += sizeof(QVariant) + arg.toByteArray().size();
+                break;
+
+            case QMetaType::QString:
+                size += sizeof(QVariant) + arg.toString().size() * sizeof(QChar);
+                break;
+
+            default:
+                size += sizeof(QVariant);
+                break;
+        }
+    }
+    return size;
+}
+
+size_t Logger::to_rank(QtMsgType type) noexcept {
+    switch (type) {
+        case QtDebugMsg:
+            return 0;
+
+        case QtInfoMsg:
+            return 1;
+
+        case QtWarningMsg:
+            return 2;
+
+        case QtCriticalMsg:
+            return 3;
+
+        case QtFatalMsg:
+            return 4;
+    }
+    return 0;
+}
+
+bool Logger::is_urgent(QtMsgType type) noexcept { return to_rank(type) >= to_rank(QtWarningMsg); }
+
+bool Logger::is_visible(const Message& msg) const noexcept { return to_rank(msg.type) >= _view_rank; }
+
+void Logger::append(std::vector<Message>& messages) {
+    if (messages.empty())
+        return;
+
+    size_t first = 0;
+    size_t new_size = std::accumulate(std::begin(messages), std::end(messages), size_t(0), [](size_t size, const Message& msg) { return size + get_size(msg); });
+    for (; first < messages.size() && (messages.size() - first > _max_count || new_size > _max_size); ++first) // note: The oldest new messages, which don't fit even into the empty log, are skipped
+        new_size -= get_size(messages[first]);
+
+    const size_t new_count = messages.size() - first;
+    size_t count = 0;
+    for (size_t size = _size; count < _log.size() && (_log.size() - count + new_count > _max_count || size + new_size > _max_size); ++count)
+        size -= get_size(_log[count]);
+
+    if (count != 0)
+        remove_front(count);
+
+    if (new_count == 0)
         return;
 
-    _log.emplace_back(msg);
-    if (_enable_func)
-        _notification_func(std::move(msg));
+    const auto begin = std::begin(messages) + first;
+    const auto end = std::end(messages);
+    const size_t visible_count = std::count_if(begin, end, [this](const Message& msg) { return is_visible(msg); });
+    if (visible_count != 0)
+        notify(Event::AboutToAppend, visible_count);
+
+    for (auto it = begin; it != end; ++it) {
+        const uint64_t pos = _removed_count + _log.size();
+        for (size_t rank = to_rank(it->type); rank > 0; --rank)
+            _level_indices[rank - 1].push_back(pos);
+
+        _log.push_back(std::move(*it));
+    }
+    _size += new_size;
+    if (visible_count != 0)
+        notify(Event::Appended, visible_count);
+}
+
+void Logger::remove_front(size_t count) {
+    const size_t visible_count = std::count_if(std::begin(_log), std::begin(_log) + count, [this](const Message& msg) { return is_visible(msg); });
+    if (visible_count != 0)
+        notify(Event::AboutToRemove, visible_count);
+
+    for (size_t i = 0; i < count; ++i) { // note: The deque releases the memory of the front messages without moving the rest ones
+        _size -= get_size(_log.front());
+        _log.pop_front();
+    }
+    _removed_count += count;
+    for (std::deque<uint64_t>& indices : _level_indices) {
+        while (!indices.empty() && indices.front() < _removed_count)
+            indices.pop_front();
+    }
+    if (visible_count != 0)
+        notify(Event::Removed, visible_count);
 }
 
-void Logger::set_notification_func(NotificationFunc&& func) {
-    const std::lock_guard<std::mutex> locker(_mutex);
-    _enable_func = false;
-    _notification_func = std::move(func);
+void Logger::notify(Event event, size_t count) const {
+    if (_notification_func)
+        _notification_func(event, count);
 }
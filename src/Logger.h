@@ -1,45 +1,115 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
+#include <QDateTime>
 #include <QString>
 #include <QtLogging>
+#include <QVariant>
+#include <QVariantList>
+
+#include "MpscRingBuffer.h"
+
+class LogFileSink;
 
 class Logger {
 public:
-    using Message = std::pair<QtMsgType, QString>;
+    struct Message {
+        QtMsgType type;
+        qint64 time; // note: Milliseconds since the epoch
+        const char* format; // note: The untranslated string literal with the %1, %2, ... placeholders or nullptr, if the only argument is the text
+        QVariantList args;
+        bool queued = false; // note: Whether the message has been handed to the log file sink already, so the batch of the sink skips it
+    };
     using Log = std::deque<Message>;
-    using NotificationFunc = std::function<void (Message&&)>;
+    enum class Event {AboutToRemove, Removed, AboutToAppend, Appended, AboutToReset, Reset};
+    using NotificationFunc = std::function<void (Event event, size_t count)>;
+
+    ~Logger();
 
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
     static std::shared_ptr<Logger> get_instance();
+    template <typename... Args>
+    static void log(QtMsgType type, const char* format, Args&&... args);
+    static QString render(const Message& msg);
     void install_handler();
     QtMsgType get_max_level() const noexcept;
+    bool is_enabled(QtMsgType type) const noexcept;
     void set_max_level(QtMsgType level);
-    Log get_log();
+    size_t get_message_count() const noexcept;
+    const Message& get_message(size_t row) const;
+    size_t get_log_size() const noexcept;
+    void set_retention(size_t max_count, size_t max_size);
     void append_message(Message&& msg);
+    void collect();
+    uint64_t get_dropped_count() const noexcept;
     void set_notification_func(NotificationFunc&& func);
+    void set_file_sink(std::unique_ptr<LogFileSink>&& sink);
 
 private:
     Logger();
 
     static void message_handler(QtMsgType type, const QMessageLogContext& context, const QString& msg);
+    template <typename T>
+    static QVariant to_variant(T&& value);
+    void write(Message&& msg);
+    static size_t get_size(const Message& msg) noexcept;
+    static size_t to_rank(QtMsgType type) noexcept;
+    static bool is_urgent(QtMsgType type) noexcept;
+    bool is_visible(const Message& msg) const noexcept;
+    void append(std::vector<Message>& messages);
+    void remove_front(size_t count);
+    void notify(Event event, size_t count) const;
 
 private:
 #ifndef NDEBUG
     static QtMessageHandler _default_handler;
 #endif
-    bool _filtered = false;
+    constexpr static size_t _ring_capacity = 8192;
+    constexpr static size_t _rank_count = 5;
+
     std::atomic<QtMsgType> _max_level = QtDebugMsg;
-    std::mutex _mutex;
-    bool _enable_func = false;
+    MpscRingBuffer<Message> _ring; // note: Any thread appends a message to the ring, the main thread collects the messages from it into the log
+    std::atomic<uint64_t> _dropped_count = 0;
+    uint64_t _reported_dropped_count = 0;
+    std::vector<Message> _new_messages;
+    size_t _max_count = 10'000;
+    size_t _max_size = 4 * 1024 * 1024;
+    size_t _size = 0;
     Log _log;
+    uint64_t _removed_count = 0; // note: The number of the messages, which have ever been removed from the front of the log, so _log[i] has the position _removed_count + i
+    std::array<std::deque<uint64_t>, _rank_count - 1> _level_indices; // note: The positions of the messages of the level Info and higher, Warning and higher and so on in ascending order; every message of the log is of the level Debug and higher
+    size_t _view_rank = 0;
     NotificationFunc _notification_func;
+    std::unique_ptr<LogFileSink> _sink;
+    std::mutex _sink_mutex; // note: Guards the replacement of the sink against a thread, which is handing an urgent message to it
+    LogFileSink* _urgent_sink = nullptr; // note: An urgent message is handed to the sink in the thread, which has logged it, and wakes the writer thread, so it doesn't wait in the ring and in the batch; the logging thread doesn't touch the file
 };
+
+template <typename... Args>
+void Logger::log(QtMsgType type, const char* format, Args&&... args) {
+    static const auto logger = get_instance();
+    if (!logger->is_enabled(type)) // note: The arguments are neither converted nor formatted, if the message is filtered out
+        return;
+
+    logger->write(Message{type, QDateTime::currentMSecsSinceEpoch(), format, {to_variant(std::forward<Args>(args))...}});
+}
+
+template <typename T>
+QVariant Logger::to_variant(T&& value) {
+    if constexpr (std::is_convertible_v<T, const char*>)
+        return QString::fromUtf8(value);
+    else
+        return QVariant::fromValue(std::forward<T>(value)); // note: QByteArray and QString are implicitly shared, so a big reply isn't copied
+}
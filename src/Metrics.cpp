@@ -0,0 +1,145 @@
+#include "Metrics.h"
+
+#include <bit>
+
+#include <QJsonValue>
+
+void Metrics::Counter::add(uint64_t value) noexcept { _value.fetch_add(value, std::memory_order::relaxed); }
+
+uint64_t Metrics::Counter::get() const noexcept { return _value.load(std::memory_order::relaxed); }
+
+void Metrics::Gauge::set(int64_t value) noexcept { _value.store(value, std::memory_order::relaxed); }
+
+int64_t Metrics::Gauge::get() const noexcept { return _value.load(std::memory_order::relaxed); }
+
+void Metrics::Histogram::record(uint64_t value) noexcept {
+    _counts[to_bucket(value)].fetch_add(1, std::memory_order::relaxed);
+    _sum.fetch_add(value, std::memory_order::relaxed);
+    uint64_t max = _max.load(std::memory_order::relaxed);
+    while (max < value && !_max.compare_exchange_weak(max, value, std::memory_order::relaxed));
+}
+
+Metrics::Histogram::Summary Metrics::Histogram::get_summary() const noexcept {
+    std::vector<uint64_t> counts(_bucket_count);
+    uint64_t total = 0;
+    for (size_t i = 0; i < _bucket_count; ++i) { // note: The buckets are read one by one without a lock, so a concurrent record may be seen partially, which is negligible for the statistics
+        counts[i] = _counts[i].load(std::memory_order::relaxed);
+        total += counts[i];
+    }
+    if (total == 0)
+        return Summary{};
+
+    return Summary{total, _sum.load(std::memory_order::relaxed) / total,
+                   get_percentile(counts, total, 0.5), get_percentile(counts, total, 0.9), get_percentile(counts, total, 0.99), get_percentile(counts, total, 0.999),
+                   _max.load(std::memory_order::relaxed)};
+}
+
+size_t Metrics::Histogram::to_bucket(uint64_t value) noexcept {
+    if (value < _sub_bucket_count)
+        return value;
+
+    const int shift = std::bit_width(value) - _sub_bucket_bits - 1;
+    return (shift + 1) * _sub_bucket_count + (value >> shift) - _sub_bucket_count;
+}
+
+uint64_t Metrics::Histogram::get_upper_bound(size_t bucket) noexcept {
+    if (bucket < _sub_bucket_count)
+        return bucket;
+
+    const int shift = bucket / _sub_bucket_count - 1;
+    return ((bucket % _sub_bucket_count + _sub_bucket_count + 1) << shift) - 1;
+}
+
+uint64_t Metrics::Histogram::get_percentile(const std::vector<uint64_t>& counts, uint64_t total, double percentile) const noexcept {
+    const auto rank = std::max(uint64_t(1), static_cast<uint64_t>(std::ceil(percentile * total)));
+    uint64_t count = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        count += counts[i];
+        if (count >= rank)
+            return std::min(get_upper_bound(i), _max.load(std::memory_order::relaxed));
+    }
+    return _max.load(std::memory_order::relaxed);
+}
+
+Metrics::Metrics() = default;
+
+std::shared_ptr<Metrics> Metrics::get_instance() {
+    static const std::shared_ptr<Metrics> metrics(new Metrics());
+    return metrics;
+}
+
+Metrics::Counter& Metrics::get_counter(const QString& name) {
+    const std::lock_guard<std::mutex> locker(_mutex);
+    std::unique_ptr<Counter>& counter = _counters[name];
+    if (!counter)
+        counter = std::make_unique<Counter>();
+
+    return *counter;
+}
+
+Metrics::Gauge& Metrics::get_gauge(const QString& name) {
+    const std::lock_guard<std::mutex> locker(_mutex);
+    std::unique_ptr<Gauge>& gauge = _gauges[name];
+    if (!gauge)
+        gauge = std::make_unique<Gauge>();
+
+    return *gauge;
+}
+
+Metrics::Histogram& Metrics::get_histogram(const QString& name) {
+    const std::lock_guard<std::mutex> locker(_mutex);
+    std::unique_ptr<Histogram>& histogram = _histograms[name];
+    if (!histogram)
+        histogram = std::make_unique<Histogram>();
+
+    return *histogram;
+}
+
+std::vector<Metrics::Sample> Metrics::get_samples() const {
+    std::vector<Sample> samples;
+    const std::lock_guard<std::mutex> locker(_mutex);
+    samples.reserve(_counters.size() + _gauges.size() + _histograms.size());
+    for (const auto& [name, counter] : _counters)
+        samples.push_back(Sample{name, QString::number(counter->get())});
+
+    for (const auto& [name, gauge] : _gauges)
+        samples.push_back(Sample{name, QString::number(gauge->get())});
+
+    for (const auto& [name, histogram] : _histograms) {
+        const Histogram::Summary summary = histogram->get_summary();
+        samples.push_back(Sample{name, QObject::tr("count %1, mean %2, p50 %3, p90 %4, p99 %5, p99.9 %6, max %7").arg(summary.count).arg(summary.mean).arg(summary.p50)
+                                                                                                                 .arg(summary.p90).arg(summary.p99).arg(summary.p999).arg(summary.max)});
+    }
+    return samples;
+}
+
+QJsonObject Metrics::to_json() const {
+    QJsonObject counters;
+    QJsonObject gauges;
+    QJsonObject histograms;
+    const std::lock_guard<std::mutex> locker(_mutex);
+    for (const auto& [name, counter] : _counters)
+        counters[name] = QJsonValue(static_cast<qint64>(counter->get()));
+
+    for (const auto& [name, gauge] : _gauges)
+        gauges[name] = QJsonValue(static_cast<qint64>(gauge->get()));
+
+    for (const auto& [name, histogram] : _histograms) {
+        const Histogram::Summary summary = histogram->get_summary();
+        QJsonObject obj;
+        obj["count"] = static_cast<qint64>(summary.count);
+        obj["mean"] = static_cast<qint64>(summary.mean);
+        obj["p50"] = static_cast<qint64>(summary.p50);
+        obj["p90"] = static_cast<qint64>(summary.p90);
+        obj["p99"] = static_cast<qint64>(summary.p99);
+        obj["p99.9"] = static_cast<qint64>(summary.p999);
+        obj["max"] = static_cast<qint64>(summary.max);
+        histograms[name] = obj;
+    }
+    QJsonObject obj;
+    obj["time"] = QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
+    obj["counters"] = counters;
+    obj["gauges"] = gauges;
+    obj["histograms"] = histograms;
+    return obj;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QJsonObject>
+#include <QString>
+
+class MetricsTest;
+
+class Metrics {
+public:
+    class Counter {
+    public:
+        void add(uint64_t value = 1) noexcept;
+        uint64_t get() const noexcept;
+
+    private:
+        std::atomic<uint64_t> _value = 0;
+    };
+
+    class Gauge {
+    public:
+        void set(int64_t value) noexcept;
+        int64_t get() const noexcept;
+
+    private:
+        std::atomic<int64_t> _value = 0;
+    };
+
+    // note: The buckets are log-linear like in HdrHistogram: every power of two is split into 32 equal sub-buckets, so a percentile has an error of 1/32 at most
+    class Histogram {
+    public:
+        struct Summary {
+            uint64_t count;
+            uint64_t mean;
+            uint64_t p50;
+            uint64_t p90;
+            uint64_t p99;
+            uint64_t p999;
+            uint64_t max;
+        };
+
+        void record(uint64_t value) noexcept;
+        Summary get_summary() const noexcept;
+
+    private:
+        friend class Metrics;
+        friend class ::MetricsTest;
+
+        static size_t to_bucket(uint64_t value) noexcept;
+        static uint64_t get_upper_bound(size_t bucket) noexcept;
+        uint64_t get_percentile(const std::vector<uint64_t>& counts, uint64_t total, double percentile) const noexcept;
+
+    private:
+        constexpr static int _sub_bucket_bits = 5;
+        constexpr static uint64_t _sub_bucket_count = 1 << _sub_bucket_bits;
+        constexpr static size_t _bucket_count = (64 - _sub_bucket_bits + 1) * _sub_bucket_count;
+
+        std::array<std::atomic<uint64_t>, _bucket_count> _counts{};
+        std::atomic<uint64_t> _sum = 0;
+        std::atomic<uint64_t> _max = 0;
+    };
+
+    struct Sample {
+        QString name;
+        QString value;
+    };
+
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    static std::shared_ptr<Metrics> get_instance();
+    Counter& get_counter(const QString& name);
+    Gauge& get_gauge(const QString& name);
+    Histogram& get_histogram(const QString& name);
+    std::vector<Sample> get_samples() const;
+    QJsonObject to_json() const;
+
+private:
+    Metrics();
+
+private:
+    mutable std::mutex _mutex; // note: It guards only the maps; the metrics themselves are updated without a lock
+    std::map<QString, std::unique_ptr<Counter>> _counters;
+    std::map<QString, std::unique_ptr<Gauge>> _gauges;
+    std::map<QString, std::unique_ptr<Histogram>> _histograms;
+};
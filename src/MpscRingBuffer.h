@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// note: A bounded queue of preallocated slots for many producers and one consumer. Every slot has a sequence number, which tells, whose turn is to use the slot: a producer's or the consumer's.
+//       A producer claims a slot with the single compare and exchange of the tail, so the producers never wait for each other under a lock. A full buffer refuses a value instead of blocking the producer.
+template <typename T>
+class MpscRingBuffer {
+public:
+    explicit MpscRingBuffer(size_t capacity);
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    bool try_push(T&& value);
+    bool try_pop(T& value);
+    size_t capacity() const noexcept;
+
+private:
+    constexpr static size_t _cache_line_size = 64;
+
+    struct alignas(_cache_line_size) Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    const size_t _mask;
+    std::unique_ptr<Slot[]> _slots;
+    alignas(_cache_line_size) std::atomic<size_t> _tail = 0;
+    alignas(_cache_line_size) size_t _head = 0;
+};
+
+template <typename T>
+MpscRingBuffer<T>::MpscRingBuffer(size_t capacity) : _mask(std::bit_ceil(capacity) - 1), _slots(std::make_unique<Slot[]>(_mask + 1)) {
+    for (size_t i = 0; i <= _mask; ++i)
+        _slots[i].sequence.store(i, std::memory_order::relaxed);
+}
+
+template <typename T>
+bool MpscRingBuffer<T>::try_push(T&& value) {
+    size_t pos = _tail.load(std::memory_order::relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &_slots[pos & _mask];
+        const size_t sequence = slot->sequence.load(std::memory_order::acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+        if (diff == 0) {
+            if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order::relaxed))
+                break;
+        } else if (diff < 0) {
+            return false; // note: The consumer hasn't released the slot since the previous lap, so the buffer is full
+        } else {
+            pos = _tail.load(std::memory_order::relaxed);
+        }
+    }
+    slot->value = std::move(value);
+    slot->sequence.store(pos + 1, std::memory_order::release);
+    return true;
+}
+
+template <typename T>
+bool MpscRingBuffer<T>::try_pop(T& value) {
+    Slot& slot = _slots[_head & _mask];
+    if (slot.sequence.load(std::memory_order::acquire) != _head + 1)
+        return false;
+
+    value = std::move(slot.value);
+    slot.sequence.store(_head + _mask + 1, std::memory_order::release);
+    ++_head;
+    return true;
+}
+
+template <typename T>
+size_t MpscRingBuffer<T>::capacity() const noexcept { return _mask + 1; }
@@ -0,0 +1,65 @@
+import QtQml
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+import "../Core" as Core
+import WebDavClient
+
+ColumnLayout {
+    function prepare() {
+        listView.model = itemModelManager.createModel(ItemModel.Metric)
+        listView.currentIndex = -1
+    }
+    function back() {
+        listView.destroyModel()
+        stackLayout.currentIndex = 0
+    }
+
+    RowLayout {
+        Core.Button {
+            text: qsTr("Back")
+            onClicked: back()
+        }
+        Core.Button {
+            text: qsTr("Export")
+            onClicked: listView.model.exportToFile()
+        }
+    }
+    Core.ListView {
+        Layout.fillHeight: true
+        Layout.fillWidth: true
+        id: listView
+        model: null
+        ScrollBar.vertical: ScrollBar {
+            policy: ScrollBar.AlwaysOn
+        }
+        delegate: Item {
+            width: ListView.view.width - ListView.view.leftMargin - ListView.view.rightMargin
+            height: nameText.contentHeight + valueText.contentHeight + contentItem.anchors.topMargin + contentItem.anchors.bottomMargin
+
+            Core.ContentItem {
+                id: contentItem
+                anchors.fill: parent
+
+                Column {
+                    anchors.fill: parent
+
+                    Text {
+                        id: nameText
+                        width: parent.width
+                        wrapMode: Text.Wrap
+                        font.bold: true
+                        text: model.name
+                    }
+                    Text {
+                        id: valueText
+                        width: parent.width
+                        wrapMode: Text.Wrap
+                        text: model.value
+                    }
+                }
+            }
+        }
+    }
+}
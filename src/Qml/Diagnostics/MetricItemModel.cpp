@@ -0,0 +1,72 @@
+#include "MetricItemModel.h"
+
+#include "../../Logger.h"
+#include "../Util.h"
+
+using namespace Qml;
+
+MetricItemModel::MetricItemModel(std::shared_ptr<Metrics> metrics, QObject* parent) : QAbstractListModel(parent), _metrics(std::move(metrics)), _samples(_metrics->get_samples()) {
+    qDebug().noquote() << QObject::tr("The metric item model is being created");
+
+    _update_timer.setInterval(1000);
+    connect(&_update_timer, &QTimer::timeout, this, &MetricItemModel::update);
+    _update_timer.start();
+}
+
+MetricItemModel::~MetricItemModel() { qDebug().noquote() << QObject::tr("The metric item model is being destroyed"); }
+
+int MetricItemModel::rowCount(const QModelIndex& parent) const { return parent.isValid() ? 0 : _samples.size(); }
+
+QVariant MetricItemModel::data(const QModelIndex& index, int role) const {
+    if (role < to_int(Role::Name) || role >= to_int(Role::EnumSize))
+        return QVariant();
+
+    const Metrics::Sample& sample = _samples[index.row()];
+    switch (to_type<Role>(role)) {
+        case Role::Name:
+            return sample.name;
+
+        case Role::Value:
+            return sample.value;
+
+        default:
+            break;
+    }
+    return QVariant();
+}
+
+QHash<int, QByteArray> MetricItemModel::roleNames() const {
+    auto names = QAbstractListModel::roleNames();
+    names.emplace(to_int(Role::Name), "name");
+    names.emplace(to_int(Role::Value), "value");
+    return names;
+}
+
+QString MetricItemModel::exportToFile() {
+    const QString path = get_export_path(QStringLiteral(".metrics.json"));
+    QSaveFile file(path);
+    if (!file.open(QIODeviceBase::WriteOnly)) {
+        Logger::log(QtCriticalMsg, QT_TR_NOOP("Could not open file \"%1\""), path);
+        return QString();
+    }
+    file.write(QJsonDocument(_metrics->to_json()).toJson());
+    if (!file.commit()) {
+        Logger::log(QtCriticalMsg, QT_TR_NOOP("Could not write file \"%1\""), path);
+        return QString();
+    }
+    Logger::log(QtInfoMsg, QT_TR_NOOP("The metrics have been exported to \"%1\""), path);
+    return path;
+}
+
+void MetricItemModel::update() {
+    std::vector<Metrics::Sample> samples = _metrics->get_samples();
+    if (samples.size() != _samples.size()) { // note: The metrics are only added, so the same count means the same names in the same order
+        beginResetModel();
+        _samples = std::move(samples);
+        endResetModel();
+        return;
+    }
+    _samples = std::move(samples);
+    if (!_samples.empty())
+        emit dataChanged(index(0), index(_samples.size() - 1), {to_int(Role::Value)});
+}
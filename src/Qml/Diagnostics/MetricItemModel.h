@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QHash>
+#include <QModelIndex>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVariant>
+#include <Qt>
+
+#include "../../Metrics.h"
+
+namespace Qml {
+    class MetricItemModel : public QAbstractListModel {
+        Q_OBJECT
+
+    public:
+        explicit MetricItemModel(std::shared_ptr<Metrics> metrics, QObject* parent = nullptr);
+        ~MetricItemModel() override;
+
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+        QHash<int, QByteArray> roleNames() const override;
+
+        Q_INVOKABLE QString exportToFile();
+
+    private:
+        void update();
+
+    private:
+        enum class Role {Name = Qt::UserRole, Value, EnumSize};
+
+        std::shared_ptr<Metrics> _metrics;
+        std::vector<Metrics::Sample> _samples;
+        QTimer _update_timer;
+    };
+}
@@ -6,6 +6,8 @@ import "Util.js" as Util
 Menu {
     implicitWidth: 120 // todo: Find a solution to resize to the content.
     property Component sortDlgComponent
+    property Component filterDlgComponent
+    property var fileModel
     property var backFunc
 
     MenuItem {
@@ -20,6 +22,18 @@ Menu {
             Util.createObjAsync(sortDlgComponent, createDlg)
         }
     }
+    MenuItem {
+        text: fileModel.hasColumnFilter() ? qsTr("Filters (on)") : qsTr("Filters")
+        onTriggered: {
+            function createDlg(comp) {
+                const dlg = Util.createPopup(comp, appWindow, "ColumnFilterDialog", {"fileModel": fileModel})
+                if (dlg !== null)
+                    dlg.open()
+            }
+
+            Util.createObjAsync(filterDlgComponent, createDlg)
+        }
+    }
     MenuItem {
         text: qsTr("Disconnect")
         onTriggered: backFunc()
@@ -2,8 +2,10 @@
 
 #include "../FileSystem/FileSystemModel.h"
 #include "../FileSystem/FileSystemObject.h"
+#include "../Trace.h"
 #include "../Util.h"
 #include "FileItemModel/Role.h"
+#include "FileItemModel/SizeDisplayer.h"
 
 using namespace Qml;
 
@@ -425,76 +427,7 @@ const std::unordered_set<QString>  FileItemModel::_special_icon_name_set{
     "video-x-generic.png"
 };
 
-class SizeDisplayer {
-public:
-    constexpr static size_t size = 7;
-
-    static QString to_string(uint64_t bytes) {
-        double sz = bytes;
-        int i = 0;
-        for (; sz >= 1024 && i < SizeDisplayer::size; ++i)
-            sz /= 1024;
-
-        assert(i < _prefixes.size());
-        return QString("%1 %2").arg(_locale.toString(sz, 'g', 3), _prefixes[i]);
-    }
-
-#ifndef NDEBUG
-    static void test() {
-        QString str = SizeDisplayer::to_string(1023);
-        assert(str.indexOf(QObject::tr("B")) != -1);
-
-        str = SizeDisplayer::to_string(1024);
-        assert(str.indexOf(QObject::tr("K")) != -1);
-
-        str = SizeDisplayer::to_string(std::pow(1024, 2) - 1);
-        assert(str.indexOf(QObject::tr("K")) != -1);
-
-        str = SizeDisplayer::to_string(std::pow(1024, 2));
-        assert(str.indexOf(QObject::tr("M")) != -1);
-
-        str = SizeDisplayer::to_string(std::pow(1024, 3) - 1);
-        assert(str.indexOf(QObject::tr("M")) != -1);
-
-        str = SizeDisplayer::to_string(std::pow(1024, 3));
-        assert(str.indexOf(QObject::tr("G")) != -1);
-
-        str = SizeDisplayer::to_string(std::pow(1024, 4) - 1);
-        assert(str.indexOf(QObject::tr("G")) != -1);
-
-        str = SizeDisplayer::to_string(std::pow(1024, 4));
-        assert(str.indexOf(QObject::tr("T")) != -1);
-
-        str = SizeDisplayer::to_string(std::pow(1024, 5) - 1);
-        assert(str.indexOf(QObject::tr("T")) != -1);
-
-        str = SizeDisplayer::to_string(std::pow(1024, 5));
-        assert(str.indexOf(QObject::tr("P")) != -1);
-
-        //str = SizeDisplayer::to_string(std::pow(1024, 6) - 1); // note: the precision of double type isn't enough; long double isn't supported by Qt
-        //assert(str.indexOf(QObject::tr("P")) != -1);
-
-        str = SizeDisplayer::to_string(std::pow(1024, 6));
-        assert(str.indexOf(QObject::tr("E")) != -1);
-
-        str = SizeDisplayer::to_string(0xFFFFFFFFFFFFFFFF);
-        assert(str.indexOf(QObject::tr("E")) != -1);
-    }
-#endif
-
-private:
-    static const std::array<QString, size> _prefixes;
-    static const QLocale _locale;
-};
-
-const std::array<QString, SizeDisplayer::size> SizeDisplayer::_prefixes{QObject::tr("B"), QObject::tr("K"), QObject::tr("M"), QObject::tr("G"), QObject::tr("T"), QObject::tr("P"), QObject::tr("E")};
-const QLocale SizeDisplayer::_locale;
-
 namespace {
-    bool is_valid_dot_pos(const QStringView& name, qsizetype pos) { return pos != -1 && pos != name.size() - 1; }
-
-    QString extract_extension(const QStringView& name, qsizetype dot_pos) { return QStringView(std::begin(name) + dot_pos + 1, std::end(name)).toString().toLower(); }
-
     QString to_string(std::chrono::sys_seconds t) {
         const time_t c_time = std::chrono::system_clock::to_time_t(t);
         const std::tm tm = *std::localtime(&c_time); // todo: replace with std::chrono::zoned_time() and std::chrono::current_zone(), when GCC will support this
@@ -505,14 +438,21 @@ namespace {
     }
 }
 
+int FileItemModel::Snapshot::size() const noexcept { return objects->size() + (curr_dir_object ? 1 : 0); }
+
+bool FileItemModel::Snapshot::is_exit(int row) const noexcept { return curr_dir_object && row == 0; }
+
+const FileSystemObject& FileItemModel::Snapshot::get_object(int row) const noexcept {
+    if (!curr_dir_object)
+        return (*objects)[row];
+
+    return row == 0 ? *curr_dir_object : (*objects)[row - 1];
+}
+
 FileItemModel::FileItemModel(std::shared_ptr<::FileSystemModel> model, QObject* parent) : QAbstractListModel(parent), _fs_model(std::move(model)) {
     qDebug().noquote() << QObject::tr("The source file item model is being created");
     _fs_model->add_notification_func(this, std::bind(&FileItemModel::update, this));
     _root = _fs_model->is_cur_dir_root_path();
-#ifndef NDEBUG
-    std::for_each(std::begin(_icon_name_by_extension_map), std::end(_icon_name_by_extension_map), [](const auto& pair) { const QPixmap pixmap(":/res/icons/" + pair.second); assert(!pixmap.isNull()); });
-    SizeDisplayer::test();
-#endif
 }
 
 FileItemModel::~FileItemModel() {
@@ -537,15 +477,8 @@ QVariant FileItemModel::data(const QModelIndex& index, int role) const {
         }
 
         case Role::Extension: {
-            if (obj.get_type() == FileSystemObject::Type::Directory)
-                return QVariant();
-
-            const QString name = obj.get_name();
-            const qsizetype i = name.lastIndexOf('.');
-            if (!is_valid_dot_pos(name, i))
-                return QVariant();
-
-            return extract_extension(name, i);
+            const QString ext = obj.get_extension();
+            return ext.isNull() ? QVariant() : ext;
         }
 
         case Role::IconName: {
@@ -619,6 +552,14 @@ QHash<int, QByteArray> FileItemModel::roleNames() const {
     return names;
 }
 
+FileSystemObject FileItemModel::get_object(int row) const { return get_object(_root, row); }
+
+bool FileItemModel::is_exit(int row) const noexcept { return !_root && row == 0; }
+
+FileItemModel::Snapshot FileItemModel::get_snapshot() const {
+    return Snapshot{_fs_model->get_objects(), _root ? nullptr : std::make_shared<const FileSystemObject>(_fs_model->get_curr_dir_object())};
+}
+
 FileSystemObject FileItemModel::get_object(bool root_path, int row) const {
     if (row == 0)
         return root_path ? _fs_model->get_object(row) : _fs_model->get_curr_dir_object();
@@ -626,21 +567,28 @@ FileSystemObject FileItemModel::get_object(bool root_path, int row) const {
     return _fs_model->get_object(row - (root_path ? 0 : 1));
 }
 
+std::unordered_set<QString> FileItemModel::get_icon_names() {
+    std::unordered_set<QString> names{QStringLiteral("folder.png"), QStringLiteral("unknown.png")};
+    for (const auto& pair : _icon_name_by_extension_map)
+        names.insert(pair.second);
+
+    return names;
+}
+
 QString FileItemModel::get_icon_name(const FileSystemObject& obj, int row) const {
     if (obj.get_type() == FileSystemObject::Type::Directory || !_root && row == 0)
         return QStringLiteral("folder.png");
 
-    const QString name = obj.get_name();
-    const qsizetype i = name.lastIndexOf('.');
-    if (!is_valid_dot_pos(name, i))
+    const QString ext = obj.get_extension();
+    if (ext.isNull())
         return QStringLiteral("unknown.png");
 
-    const QString ext = extract_extension(name, i);
     const auto icon_name_it = _icon_name_by_extension_map.find(ext);
     return icon_name_it == std::end(_icon_name_by_extension_map) ? QStringLiteral("unknown.png") : icon_name_it->second;
 }
 
 void FileItemModel::update() {
+    const Trace::Span span("FileItemModel::update");
     beginResetModel();
     _root = _fs_model->is_cur_dir_root_path();
     endResetModel();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
@@ -21,6 +22,15 @@ namespace Qml {
         Q_OBJECT
 
     public:
+        struct Snapshot { // note: Can be read on another thread, because the listing it shares is never modified
+            std::shared_ptr<const std::deque<FileSystemObject>> objects;
+            std::shared_ptr<const FileSystemObject> curr_dir_object; // note: Null in the root path, which has no exit row
+
+            int size() const noexcept;
+            bool is_exit(int row) const noexcept;
+            const FileSystemObject& get_object(int row) const noexcept;
+        };
+
         explicit FileItemModel(std::shared_ptr<::FileSystemModel> model, QObject* parent = nullptr);
         ~FileItemModel() override;
 
@@ -30,6 +40,11 @@ namespace Qml {
 
         QHash<int, QByteArray> roleNames() const override;
 
+        FileSystemObject get_object(int row) const;
+        bool is_exit(int row) const noexcept;
+        Snapshot get_snapshot() const;
+        static std::unordered_set<QString> get_icon_names();
+
     private:
         FileSystemObject get_object(bool root_path, int row) const;
         QString get_icon_name(const FileSystemObject& obj, int row) const;
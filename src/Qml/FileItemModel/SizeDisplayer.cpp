@@ -0,0 +1,18 @@
+#include "SizeDisplayer.h"
+
+#include <QObject>
+
+using namespace Qml;
+
+const std::array<QString, SizeDisplayer::size> SizeDisplayer::_prefixes{QObject::tr("B"), QObject::tr("K"), QObject::tr("M"), QObject::tr("G"), QObject::tr("T"), QObject::tr("P"), QObject::tr("E")};
+const QLocale SizeDisplayer::_locale;
+
+QString SizeDisplayer::to_string(uint64_t bytes) {
+    double sz = bytes;
+    int i = 0;
+    for (; sz >= 1024 && i < SizeDisplayer::size; ++i)
+        sz /= 1024;
+
+    assert(i < _prefixes.size());
+    return QString("%1 %2").arg(_locale.toString(sz, 'g', 3), _prefixes[i]);
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <QLocale>
+#include <QString>
+
+namespace Qml {
+    class SizeDisplayer {
+    public:
+        constexpr static size_t size = 7;
+
+        static QString to_string(uint64_t bytes);
+
+    private:
+        static const std::array<QString, size> _prefixes;
+        static const QLocale _locale;
+    };
+}
@@ -11,6 +11,8 @@ ColumnLayout {
     function prepare() {
         searchTextField.text = ""
         currPathLabel.text = ""
+        timingLabel.text = ""
+        wholeTreeCheckBox.checked = false
 
         function setModel() {
             listView.model = itemModelManager.createModel(ItemModel.File)
@@ -22,15 +24,26 @@ ColumnLayout {
         fileSystemModel.errorOccurred.connect(() => { fileSystemModel.replyGot.disconnect(setModel) })
     }
     function back() {
+        closeSearchResults()
         listView.destroyModel()
         console.debug(qsTr("QML: The file system model is being disconnected"))
         fileSystemModel.disconnect()
         stackLayout.currentIndex = 0
     }
+    function searchModel() { return wholeTreeCheckBox.checked ? resultListView.model : listView.model }
+    function closeSearchResults() {
+        if (resultListView.model !== null)
+            resultListView.destroyModel()
+
+        wholeTreeCheckBox.checked = false
+    }
 
     Connections {
         target: fileSystemModel
-        function onReplyGot() { currPathLabel.text = fileSystemModel.getCurrentPath() }
+        function onReplyGot() {
+            currPathLabel.text = fileSystemModel.getCurrentPath()
+            timingLabel.text = fileSystemModel.getRequestTiming()
+        }
     }
     Core.SelectionSequentialAnimation {
         id: animation
@@ -39,6 +52,7 @@ ColumnLayout {
     Core.Timer {
         id: delayTimer
         property var model: null
+        property string absolutePath: ""
         onTriggered: {
             function createDlg(comp) {
                 const dlg = Util.createPopup(comp, appWindow, "ProgressDialog", {})
@@ -46,12 +60,23 @@ ColumnLayout {
                     return
 
                 const mainStackLayout = stackLayout
-                dlg.onOpened.connect(() => { console.debug(qsTr("QML: A new file list was requested")); fileSystemModel.requestFileList(model.name) })
+                const path = absolutePath
+                dlg.onOpened.connect(() => {
+                    console.debug(qsTr("QML: A new file list was requested"))
+                    if (path === "")
+                        fileSystemModel.requestFileList(model.name)
+                    else
+                        fileSystemModel.requestAbsoluteFileList(path)
+                })
                 dlg.rejected.connect(() => { console.debug(qsTr("QML: The request is being aborted")); fileSystemModel.abortRequest() })
                 dlg.closed.connect(() => { mainStackLayout.enabled = true })
                 dlg.open()
             }
 
+            if (absolutePath !== "") {
+                searchTextField.clear()
+                closeSearchResults()
+            }
             stackLayout.enabled = false
             Util.createObjAsync(progressDlgComponent, createDlg)
         }
@@ -61,7 +86,7 @@ ColumnLayout {
             id: searchTextField
             Layout.fillWidth: true
             placeholderText: qsTr("Search by name")
-            onTextEdited: listView.model.searchWithTimer(text)
+            onTextEdited: searchModel().searchWithTimer(text)
 
             Core.Button {
                 anchors.right: parent.right
@@ -69,7 +94,7 @@ ColumnLayout {
                 width: height
                 background: Item {}
                 text: "×"
-                onClicked: { searchTextField.clear(); listView.model.search(searchTextField.text) }
+                onClicked: { searchTextField.clear(); searchModel().search(searchTextField.text) }
             }
         }
         CheckBox {
@@ -78,7 +103,31 @@ ColumnLayout {
             onClicked: {
                 const cs = settings.getSearchCSFlag()
                 settings.setSearchCSFlag(!cs)
-                listView.model.repeatSearch(0)
+                searchModel().repeatSearch(0)
+            }
+        }
+        CheckBox {
+            text: qsTr("Fuzzy")
+            enabled: !wholeTreeCheckBox.checked
+            checkState: settings.getSearchFuzzyFlag() ? Qt.Checked : Qt.Unchecked
+            onClicked: {
+                const fuzzy = settings.getSearchFuzzyFlag()
+                settings.setSearchFuzzyFlag(!fuzzy)
+                searchModel().repeatSearch(0)
+            }
+        }
+        CheckBox {
+            id: wholeTreeCheckBox
+            text: qsTr("Whole\ntree")
+            onClicked: {
+                if (checked) {
+                    resultListView.model = itemModelManager.createModel(ItemModel.SearchResult)
+                    resultListView.currentIndex = -1
+                    listView.model.search("")
+                } else {
+                    resultListView.destroyModel()
+                }
+                searchModel().search(searchTextField.text)
             }
         }
     }
@@ -89,16 +138,27 @@ ColumnLayout {
         elide: Text.ElideMiddle
         font.bold: true
     }
+    Label {
+        id: timingLabel
+        Layout.fillWidth: true
+        horizontalAlignment: Text.AlignHCenter
+        wrapMode: Text.Wrap
+        font.pointSize: currPathLabel.font.pointSize * 0.8
+        color: "gray"
+    }
     Core.ListView {
         id: listView
         Layout.fillHeight: true
         Layout.fillWidth: true
+        visible: !wholeTreeCheckBox.checked
         model: null
         property Component menuComponent
         property Component sortDlgComponent
+        property Component filterDlgComponent
         Component.onCompleted: {
             menuComponent = Qt.createComponent("FileItemMenu.qml", Component.Asynchronous)
             sortDlgComponent = Qt.createComponent("Sort/SortDialog.qml", Component.Asynchronous)
+            filterDlgComponent = Qt.createComponent("Sort/ColumnFilterDialog.qml", Component.Asynchronous)
         }
         delegate: Item {
             id: delegateItem
@@ -177,6 +237,7 @@ ColumnLayout {
                         return
 
                     delayTimer.model = model
+                    delayTimer.absolutePath = ""
                     delayTimer.start()
                 }
                 onPressAndHold: (event) => {
@@ -186,7 +247,7 @@ ColumnLayout {
 
                     function createMenu(comp) {
                         const item = delegateItem.ListView.view.itemAtIndex(index)
-                        const menu = Util.createPopup(comp, item, "FileItemMenu", {"sortDlgComponent": listView.sortDlgComponent, "backFunc": back})
+                        const menu = Util.createPopup(comp, item, "FileItemMenu", {"sortDlgComponent": listView.sortDlgComponent, "filterDlgComponent": listView.filterDlgComponent, "fileModel": listView.model, "backFunc": back})
                         menu.popup(item, event.x, event.y)
                     }
                     Util.createObjAsync(listView.menuComponent, createMenu)
@@ -194,4 +255,53 @@ ColumnLayout {
             }
         }
     }
+    Core.ListView {
+        id: resultListView
+        Layout.fillHeight: true
+        Layout.fillWidth: true
+        visible: wholeTreeCheckBox.checked
+        model: null
+        delegate: Item {
+            id: resultDelegateItem
+            height: resultNameText.contentHeight + resultPathText.contentHeight + resultContentItem.anchors.topMargin + resultContentItem.anchors.bottomMargin
+            width: ListView.view.width - ListView.view.leftMargin - ListView.view.rightMargin
+            required property int index
+            required property var model
+
+            Core.ContentItem {
+                id: resultContentItem
+                anchors.fill: parent
+
+                ColumnLayout {
+                    anchors.fill: parent
+                    spacing: 0
+
+                    Text {
+                        id: resultNameText
+                        Layout.fillWidth: true
+                        font.bold: true
+                        font.pointSize: 14
+                        wrapMode: Text.Wrap
+                        text: model.name
+                    }
+                    Text {
+                        id: resultPathText
+                        Layout.fillWidth: true
+                        elide: Text.ElideMiddle
+                        text: model.path
+                    }
+                }
+            }
+            MouseArea {
+                anchors.fill: parent
+                onClicked: {
+                    const view = resultDelegateItem.ListView.view
+                    animation.obj = view.itemAtIndex(index)
+                    animation.start()
+                    delayTimer.absolutePath = model.dirPath
+                    delayTimer.start()
+                }
+            }
+        }
+    }
 }
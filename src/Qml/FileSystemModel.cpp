@@ -1,5 +1,7 @@
 #include "FileSystemModel.h"
 
+#include "../Logger.h"
+
 Qml::FileSystemModel::FileSystemModel(std::shared_ptr<::FileSystemModel> model) : _fs_model(std::move(model)) {
     _fs_model->set_error_func(std::bind(&FileSystemModel::handle_error, this, std::placeholders::_1, std::placeholders::_2));
     _fs_model->add_notification_func(this, std::bind(&FileSystemModel::replyGot, this));
@@ -20,12 +22,20 @@ void Qml::FileSystemModel::requestFileList(const QString& relative_path) {
     _fs_model->request_file_list(relative_path);
 }
 
+void Qml::FileSystemModel::requestAbsoluteFileList(const QString& absolute_path) {
+    maxProgressEnabled(false);
+    progressTextChanged(tr("Getting the list of files…"));
+    _fs_model->request_abs_file_list(absolute_path);
+}
+
 void Qml::FileSystemModel::abortRequest() { _fs_model->abort_request(); }
 
 void Qml::FileSystemModel::disconnect() { _fs_model->disconnect(); }
 
 QString Qml::FileSystemModel::getCurrentPath() const { return _fs_model->get_current_path(); }
 
+QString Qml::FileSystemModel::getRequestTiming() const { return _fs_model->get_request_timing().to_string(); }
+
 void Qml::FileSystemModel::handle_error(::FileSystemModel::Error custom_error, QNetworkReply::NetworkError qt_error) {
     if (custom_error == ::FileSystemModel::Error::ReplyParseError) {
         errorOccurred(QObject::tr("Reply parse error"));
@@ -205,6 +215,6 @@ void Qml::FileSystemModel::handle_error(::FileSystemModel::Error custom_error, Q
             log_str = QObject::tr("Unknown error");
             break;
     }
-    qCritical(qUtf8Printable(QObject::tr("Network error: %s")), qUtf8Printable(log_str));
+    Logger::log(QtCriticalMsg, QT_TR_NOOP("Network error: %1"), log_str);
     errorOccurred(display_str);
 }
@@ -20,9 +20,11 @@ namespace Qml {
         Q_INVOKABLE void setServerInfo(const QString& addr, uint16_t port);
         Q_INVOKABLE void setRootPath(const QString& absolute_path);
         Q_INVOKABLE void requestFileList(const QString& relative_path);
+        Q_INVOKABLE void requestAbsoluteFileList(const QString& absolute_path);
         Q_INVOKABLE void abortRequest();
         Q_INVOKABLE void disconnect();
         Q_INVOKABLE QString getCurrentPath() const;
+        Q_INVOKABLE QString getRequestTiming() const;
 
     signals:
         void maxProgressEnabled(bool enabled);
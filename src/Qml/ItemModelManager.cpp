@@ -3,11 +3,14 @@
 #include "../FileSystem/FileSystemModel.h"
 #include "../Json/SettingsJsonFile.h"
 #include "../Logger.h"
+#include "../Metrics.h"
 #include "../ServerInfo.h"
 #include "../ServerInfoManager.h"
 #include "../Util.h"
+#include "Diagnostics/MetricItemModel.h"
 #include "FileItemModel/FileItemModel.h"
 #include "Logger/LogItemModel.h"
+#include "Search/SearchResultItemModel.h"
 #include "ServerItemModel.h"
 #include "Sort/FileSortFilterItemModel.h"
 #include "Sort/SortParamItemModel.h"
@@ -34,6 +37,14 @@ QAbstractItemModel* Qml::ItemModelManager::createModel(ItemModel::Model model) {
             return new SortParamItemModel(_settings);
         }
 
+        case ItemModel::Model::SearchResult: {
+            return new SearchResultItemModel(_settings, _fs_model);
+        }
+
+        case ItemModel::Model::Metric: {
+            return new MetricItemModel(Metrics::get_instance());
+        }
+
         default: {
             qCritical(qUtf8Printable(QObject::tr("Unknown item model type index: %d")), to_int(model));
             break;
@@ -17,7 +17,7 @@ namespace Qml {
         QML_ELEMENT
 
     public:
-        enum class Model {Server, Log, File, SortParam};
+        enum class Model {Server, Log, File, SortParam, SearchResult, Metric};
         Q_ENUM(Model);
     };
 
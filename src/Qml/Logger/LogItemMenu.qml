@@ -11,7 +11,19 @@ Menu {
         onTriggered: view.model.copyToClipboard(view.currentIndex)
     }
     MenuItem {
-        text: qsTr("Copy all")
-        onTriggered: view.model.copyAllToClipboard()
+        text: qsTr("Copy last")
+        onTriggered: view.model.copyTailToClipboard()
+    }
+    MenuItem {
+        text: qsTr("Export")
+        onTriggered: view.model.exportToFile()
+    }
+    MenuItem {
+        text: view.model.isTracing() ? qsTr("Stop tracing") : qsTr("Start tracing")
+        onTriggered: view.model.setTracing(!view.model.isTracing())
+    }
+    MenuItem {
+        text: qsTr("Export trace")
+        onTriggered: view.model.exportTrace()
     }
 }
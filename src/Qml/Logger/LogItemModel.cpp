@@ -1,6 +1,7 @@
 #include "LogItemModel.h"
 
 #include "../../Logger.h"
+#include "../../Trace.h"
 #include "../Util.h"
 
 using namespace Qml;
@@ -24,7 +25,7 @@ namespace {
         return QColor(0x00, 0x00, 0x00);
     }
 
-    QString&& insert_indentation(QString&& str) { return std::move(str.replace('\n', QStringLiteral("\n    "))); }
+    QString insert_indentation(QString str) { return str.replace('\n', QStringLiteral("\n    ")); }
 }
 
 LogItemModel::LogItemModel(std::shared_ptr<Logger> logger, QObject* parent) : QAbstractListModel(parent), _logger(std::move(logger)) {
@@ -34,14 +35,36 @@ LogItemModel::LogItemModel(std::shared_ptr<Logger> logger, QObject* parent) : QA
     connect(&_update_timer, &QTimer::timeout, this, &LogItemModel::update);
     _update_timer.start();
 
-    const auto update = [this](Logger::Message&& message) {
-        const std::lock_guard<std::mutex> locker(_mutex);
-        _sync_log.emplace_back(std::make_pair(to_color(message.first), message.second));
-        _needs_to_update.store(true, std::memory_order::relaxed);
+    _logger->collect();
+    const auto handle_event = [this](Logger::Event event, size_t count) { // note: The model is a view of the log, so it only follows the changes of the log, which the logger makes in the main thread
+        const int size = _logger->get_message_count();
+        switch (event) {
+            case Logger::Event::AboutToRemove:
+                beginRemoveRows(QModelIndex(), 0, count - 1);
+                break;
+
+            case Logger::Event::Removed:
+                endRemoveRows();
+                break;
+
+            case Logger::Event::AboutToAppend:
+                beginInsertRows(QModelIndex(), size, size + count - 1);
+                break;
+
+            case Logger::Event::Appended:
+                endInsertRows();
+                break;
+
+            case Logger::Event::AboutToReset:
+                beginResetModel();
+                break;
+
+            case Logger::Event::Reset:
+                endResetModel();
+                break;
+        }
     };
-    _logger->set_notification_func(update);
-    Logger::Log log = _logger->get_log();
-    std::transform(std::make_move_iterator(std::begin(log)), std::make_move_iterator(std::end(log)), std::back_inserter(_log), [](Logger::Message&& message) { return std::make_pair(to_color(message.first), insert_indentation(std::move(message.second))); });
+    _logger->set_notification_func(handle_event);
 }
 
 LogItemModel::~LogItemModel() {
@@ -49,19 +72,19 @@ LogItemModel::~LogItemModel() {
     _logger->set_notification_func(nullptr);
 }
 
-int LogItemModel::rowCount(const QModelIndex& parent) const { return parent.isValid() ? 0 : _log.size(); }
+int LogItemModel::rowCount(const QModelIndex& parent) const { return parent.isValid() ? 0 : _logger->get_message_count(); }
 
 QVariant LogItemModel::data(const QModelIndex& index, int role) const {
     if (role < to_int(Role::Colour) || role >= to_int(Role::EnumSize))
         return QVariant();
 
-    const Message& msg = _log[index.row()];
+    const Logger::Message& msg = _logger->get_message(index.row()); // note: The logger maps the row to the message of the current level in constant time
     switch (to_type<Role>(role)) {
         case Role::Colour:
-            return msg.first;
+            return to_color(msg.type);
 
         case Role::Text:
-            return msg.second;
+            return insert_indentation(Logger::render(msg)); // note: The text is rendered only for the shown rows
 
         default:
             break;
@@ -78,30 +101,75 @@ QHash<int, QByteArray> LogItemModel::roleNames() const {
 
 void LogItemModel::copyToClipboard(int index) {
     QClipboard* clipboard = QGuiApplication::clipboard();
-    clipboard->setText(_log[index].second);
+    clipboard->setText(insert_indentation(Logger::render(_logger->get_message(index))));
 }
 
-void LogItemModel::copyAllToClipboard() {
+void LogItemModel::copyTailToClipboard() {
+    std::vector<QString> lines;
+    qsizetype size = 0;
+    for (size_t row = _logger->get_message_count(); row > 0 && size < _clipboard_max_size; --row) { // note: Only the last messages are rendered, so the memory doesn't depend on the size of the log
+        lines.push_back(insert_indentation(Logger::render(_logger->get_message(row - 1))));
+        size += lines.back().size() + 1;
+    }
     QString text;
-    text.reserve(_log.size() * std::pow(2, 15));
-    std::for_each(std::cbegin(_log), std::cend(_log), [&text](const Message& msg) { text += msg.second + '\n'; });
-    if (!text.isEmpty())
-        text.resize(text.size() - 1);
+    text.reserve(std::min(size, _clipboard_max_size));
+    for (auto it = std::rbegin(lines); it != std::rend(lines); ++it) {
+        if (!text.isEmpty())
+            text += '\n';
+
+        text += *it;
+    }
+    if (text.size() > _clipboard_max_size)
+        text.remove(0, text.size() - _clipboard_max_size);
 
     QClipboard* clipboard = QGuiApplication::clipboard();
     clipboard->setText(text);
 }
 
-void LogItemModel::update() {
-    if (!_needs_to_update.load(std::memory_order::relaxed))
-        return;
+QString LogItemModel::exportToFile() {
+    const QString path = get_export_path(QStringLiteral(".log"));
+    QSaveFile file(path);
+    if (!file.open(QIODeviceBase::WriteOnly)) {
+        Logger::log(QtCriticalMsg, QT_TR_NOOP("Could not open file \"%1\""), path);
+        return QString();
+    }
+    QByteArray chunk;
+    chunk.reserve(_export_chunk_size);
+    for (size_t row = 0, count = _logger->get_message_count(); row < count; ++row) { // note: Every message is rendered and written separately, so the memory doesn't depend on the size of the log
+        chunk += insert_indentation(Logger::render(_logger->get_message(row))).toUtf8();
+        chunk += '\n';
+        if (chunk.size() >= _export_chunk_size) {
+            file.write(chunk);
+            chunk.resize(0); // note: Unlike clear(), resize() keeps the capacity
+        }
+    }
+    file.write(chunk);
+    if (!file.commit()) {
+        Logger::log(QtCriticalMsg, QT_TR_NOOP("Could not write file \"%1\""), path);
+        return QString();
+    }
+    Logger::log(QtInfoMsg, QT_TR_NOOP("The log has been exported to \"%1\""), path);
+    return path;
+}
+
+bool LogItemModel::isTracing() const { return Trace::is_enabled(); }
 
-    const size_t sz = _log.size();
-    {
-        const std::lock_guard<std::mutex> locker(_mutex);
-        beginInsertRows(QModelIndex(), sz, sz + _sync_log.size() - 1);
-        std::transform(std::make_move_iterator(std::begin(_sync_log)), std::make_move_iterator(std::end(_sync_log)), std::back_inserter(_log), [](Message&& message) { return std::make_pair(message.first, insert_indentation(std::move(message.second))); });
-        _sync_log.clear();
+void LogItemModel::setTracing(bool enabled) { Trace::set_enabled(enabled); }
+
+QString LogItemModel::exportTrace() {
+    const QString path = get_export_path(QStringLiteral(".trace.json")); // note: The file is opened by chrome://tracing or ui.perfetto.dev
+    QSaveFile file(path);
+    if (!file.open(QIODeviceBase::WriteOnly)) {
+        Logger::log(QtCriticalMsg, QT_TR_NOOP("Could not open file \"%1\""), path);
+        return QString();
+    }
+    file.write(Trace::to_json());
+    if (!file.commit()) {
+        Logger::log(QtCriticalMsg, QT_TR_NOOP("Could not write file \"%1\""), path);
+        return QString();
     }
-    endInsertRows();
+    Logger::log(QtInfoMsg, QT_TR_NOOP("The trace has been exported to \"%1\""), path);
+    return path;
 }
+
+void LogItemModel::update() { _logger->collect(); }
@@ -1,9 +1,6 @@
 #pragma once
 
-#include <atomic>
-#include <deque>
 #include <memory>
-#include <mutex>
 
 #include <QAbstractListModel>
 #include <QByteArray>
@@ -33,20 +30,22 @@ namespace Qml {
         QHash<int, QByteArray> roleNames() const override;
 
         Q_INVOKABLE void copyToClipboard(int index);
-        Q_INVOKABLE void copyAllToClipboard();
+        Q_INVOKABLE void copyTailToClipboard();
+        Q_INVOKABLE QString exportToFile();
+        Q_INVOKABLE bool isTracing() const;
+        Q_INVOKABLE void setTracing(bool enabled);
+        Q_INVOKABLE QString exportTrace();
 
     private:
         void update();
 
     private:
-        using Message = std::pair<QColor, QString>;
         enum class Role {Colour = Qt::UserRole, Text, EnumSize};
 
+        constexpr static qsizetype _clipboard_max_size = 256 * 1024; // note: In characters
+        constexpr static qsizetype _export_chunk_size = 64 * 1024; // note: In bytes
+
         std::shared_ptr<Logger> _logger;
-        std::atomic<bool> _needs_to_update = false;
-        std::mutex _mutex;
         QTimer _update_timer;
-        std::deque<Message> _sync_log;
-        std::deque<Message> _log;
     };
 }
@@ -5,6 +5,7 @@ import QtQuick.Layouts
 //import Qt.labs.platform
 
 import "Core" as Core
+import "Diagnostics" as Diagnostics
 import "Logger" as Logger
 import WebDavClient
 
@@ -33,6 +34,10 @@ ApplicationWindow {
                 logPageColumnLayout.back()
                 break
 
+            case 4:
+                diagnosticsPageColumnLayout.back()
+                break
+
             default:
                 console.error(qsTr("QML: Unknown page index in the stack layout"))
                 return
@@ -70,6 +75,7 @@ ApplicationWindow {
             fileListPage: fileListPageColumnLayout
             settingsPage: settingsPageColumnLayout
             logPage: logPageColumnLayout
+            diagnosticsPage: diagnosticsPageColumnLayout
         }
 
         FileListPageColumnLayout {
@@ -83,5 +89,9 @@ ApplicationWindow {
         Logger.LogPageColumnLayout {
             id: logPageColumnLayout
         }
+
+        Diagnostics.DiagnosticsPageColumnLayout {
+            id: diagnosticsPageColumnLayout
+        }
     }
 }
@@ -0,0 +1,90 @@
+#include "SearchResultItemModel.h"
+
+#include "../../FileSystem/FileSystemModel.h"
+#include "../../Json/SettingsJsonFile.h"
+#include "../Util.h"
+
+using namespace Qml;
+
+SearchResultItemModel::SearchResultItemModel(std::shared_ptr<SettingsJsonFile> settings, std::shared_ptr<::FileSystemModel> model, QObject* parent)
+    : QAbstractListModel(parent), _settings(std::move(settings)), _fs_model(std::move(model))
+{
+    qDebug().noquote() << QObject::tr("The search result item model is being created");
+    _timer.setSingleShot(true);
+    connect(&_timer, &QTimer::timeout, this, &SearchResultItemModel::update);
+}
+
+SearchResultItemModel::~SearchResultItemModel() {
+    qDebug().noquote() << QObject::tr("The search result item model is being destroyed");
+    _fs_model->abort_search();
+}
+
+int SearchResultItemModel::rowCount(const QModelIndex& parent) const { return parent.isValid() ? 0 : _matches.size(); }
+
+QVariant SearchResultItemModel::data(const QModelIndex& index, int role) const {
+    if (role < to_int(Role::Name) || role > to_int(Role::FileFlag))
+        return QVariant();
+
+    const NameIndex::Match& match = _matches[index.row()];
+    switch (to_type<Role>(role)) {
+        case Role::Name:
+            return match.name;
+
+        case Role::Path:
+            return match.path;
+
+        case Role::DirPath:
+            return match.is_dir ? match.path : match.path.left(match.path.size() - match.name.size());
+
+        case Role::FileFlag:
+            return !match.is_dir;
+    }
+    return QVariant();
+}
+
+QHash<int, QByteArray> SearchResultItemModel::roleNames() const {
+    auto names = QAbstractListModel::roleNames();
+    names.emplace(to_int(Role::Name), "name");
+    names.emplace(to_int(Role::Path), "path");
+    names.emplace(to_int(Role::DirPath), "dirPath");
+    names.emplace(to_int(Role::FileFlag), "isFile");
+    return names;
+}
+
+void SearchResultItemModel::search(const QString& text) {
+    if (_text == text)
+        return;
+
+    _text = text;
+    repeatSearch(0);
+}
+
+void SearchResultItemModel::searchWithTimer(const QString& text) {
+    if (_text == text)
+        return;
+
+    _text = text;
+    repeatSearch(600);
+}
+
+void SearchResultItemModel::repeatSearch(int msec) {
+    _timer.stop();
+    _timer.start(msec);
+}
+
+void SearchResultItemModel::update() {
+    beginResetModel();
+    _matches.clear();
+    endResetModel();
+    const auto add_matches = [this](std::vector<NameIndex::Match>&& matches) {
+        const int first = _matches.size();
+        beginInsertRows(QModelIndex(), first, first + matches.size() - 1);
+        std::move(std::begin(matches), std::end(matches), std::back_inserter(_matches));
+        endInsertRows();
+    };
+    const auto finish = [](bool ok) {
+        if (!ok)
+            qWarning().noquote() << QObject::tr("The search hasn't been completed");
+    };
+    _fs_model->search(_text, _settings->get_search_cs_flag(), _max_result_count, add_matches, finish);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QHash>
+#include <QModelIndex>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVariant>
+#include <Qt>
+
+#include "../../FileSystem/NameIndex.h"
+
+class FileSystemModel;
+class SettingsJsonFile;
+
+namespace Qml {
+    class SearchResultItemModel : public QAbstractListModel {
+        Q_OBJECT
+
+    public:
+        SearchResultItemModel(std::shared_ptr<SettingsJsonFile> settings, std::shared_ptr<::FileSystemModel> model, QObject* parent = nullptr);
+        ~SearchResultItemModel() override;
+
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+        QHash<int, QByteArray> roleNames() const override;
+
+        Q_INVOKABLE void search(const QString& text);
+        Q_INVOKABLE void searchWithTimer(const QString& text);
+        Q_INVOKABLE void repeatSearch(int msec);
+
+    private:
+        void update();
+
+    private:
+        enum class Role {Name = Qt::UserRole, Path, DirPath, FileFlag};
+
+        constexpr static size_t _max_result_count = 1000;
+
+        std::shared_ptr<SettingsJsonFile> _settings;
+        std::shared_ptr<::FileSystemModel> _fs_model;
+        QTimer _timer;
+        QString _text;
+        std::vector<NameIndex::Match> _matches;
+    };
+}
@@ -4,6 +4,7 @@ import QtQuick.Controls
 import QtQuick.Layouts
 
 import "Core" as Core
+import "Diagnostics" as Diagnostics
 import "Logger" as Logger
 import "Util.js" as Util
 import WebDavClient
@@ -12,6 +13,7 @@ ColumnLayout {
     property FileListPageColumnLayout fileListPage
     property SettingsPageColumnLayout settingsPage
     property Logger.LogPageColumnLayout logPage
+    property Diagnostics.DiagnosticsPageColumnLayout diagnosticsPage
 
     Core.SelectionSequentialAnimation {
         id: animation
@@ -83,6 +85,13 @@ ColumnLayout {
                 stackLayout.currentIndex = 3
             }
         }
+        Core.Button {
+            text: qsTr("Diagnostics")
+            onClicked: {
+                diagnosticsPage.prepare()
+                stackLayout.currentIndex = 4
+            }
+        }
     }
     Core.ListView {
         id: listView
@@ -25,10 +25,30 @@ void Settings::setCurrentLogLevel(int index) {
     _settings->set_max_log_level(pair.second);
 }
 
+int Settings::getLogMaxCount() const { return _settings->get_log_max_count(); }
+
+void Settings::setLogMaxCount(int count) { _settings->set_log_max_count(count); }
+
+int Settings::getLogMaxSize() const { return _settings->get_log_max_size(); }
+
+void Settings::setLogMaxSize(int kib) { _settings->set_log_max_size(kib); }
+
+bool Settings::getLogFileFlag() const { return _settings->get_log_file_flag(); }
+
+void Settings::setLogFileFlag(bool enabled) { _settings->set_log_file_flag(enabled); }
+
+bool Settings::getLogCompressionFlag() const { return _settings->get_log_compression_flag(); }
+
+void Settings::setLogCompressionFlag(bool compress) { _settings->set_log_compression_flag(compress); }
+
 bool Settings::getSearchCSFlag() const { return _settings->get_search_cs_flag(); }
 
 void Settings::setSearchCSFlag(bool caseSensitive) { _settings->set_search_cs_flag(caseSensitive); }
 
+bool Settings::getSearchFuzzyFlag() const { return _settings->get_search_fuzzy_flag(); }
+
+void Settings::setSearchFuzzyFlag(bool fuzzy) { _settings->set_search_fuzzy_flag(fuzzy); }
+
 QStringList Settings::get_level_desc_list() const {
     QStringList dataList;
     std::transform(std::begin(_desc_level_pairs), std::end(_desc_level_pairs), std::back_inserter(dataList), [](const std::pair<QString, QtMsgType>& pair) { return pair.first; });
@@ -24,8 +24,18 @@ namespace Qml {
         Q_INVOKABLE void setDownloadPath(const QString& path);
         Q_INVOKABLE int getCurrentLogLevel() const;
         Q_INVOKABLE void setCurrentLogLevel(int index);
+        Q_INVOKABLE int getLogMaxCount() const;
+        Q_INVOKABLE void setLogMaxCount(int count);
+        Q_INVOKABLE int getLogMaxSize() const;
+        Q_INVOKABLE void setLogMaxSize(int kib);
+        Q_INVOKABLE bool getLogFileFlag() const;
+        Q_INVOKABLE void setLogFileFlag(bool enabled);
+        Q_INVOKABLE bool getLogCompressionFlag() const;
+        Q_INVOKABLE void setLogCompressionFlag(bool compress);
         Q_INVOKABLE bool getSearchCSFlag() const;
         Q_INVOKABLE void setSearchCSFlag(bool caseSensitive);
+        Q_INVOKABLE bool getSearchFuzzyFlag() const;
+        Q_INVOKABLE void setSearchFuzzyFlag(bool fuzzy);
         QStringList get_level_desc_list() const;
 
     private:
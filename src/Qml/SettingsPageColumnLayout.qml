@@ -8,6 +8,10 @@ ColumnLayout {
     function prepare() {
         //pathTxtField.text = settings.getDownloadPath()
         logLevelComboBox.currentIndex = settings.getCurrentLogLevel()
+        logMaxCountSpinBox.value = settings.getLogMaxCount()
+        logMaxSizeSpinBox.value = settings.getLogMaxSize()
+        logFileCheckBox.checked = settings.getLogFileFlag()
+        logCompressionCheckBox.checked = settings.getLogCompressionFlag()
         saveSettingsButton.enabled = false
     }
     function back() { stackLayout.currentIndex = 0 }
@@ -27,6 +31,10 @@ ColumnLayout {
             onClicked: {
                 //settings.setDownloadPath(pathTxtField.text)
                 settings.setCurrentLogLevel(logLevelComboBox.currentIndex)
+                settings.setLogMaxCount(logMaxCountSpinBox.value)
+                settings.setLogMaxSize(logMaxSizeSpinBox.value)
+                settings.setLogCompressionFlag(logCompressionCheckBox.checked)
+                settings.setLogFileFlag(logFileCheckBox.checked)
                 back()
             }
         }
@@ -40,7 +48,9 @@ ColumnLayout {
             anchors.fill: parent
             anchors.margins: 5
             spacing: 5
-            function hasChanges() { return /*settings.getDownloadPath() !== pathTxtField.text || */settings.getCurrentLogLevel() !== logLevelComboBox.currentIndex }
+            function hasChanges() { return /*settings.getDownloadPath() !== pathTxtField.text || */settings.getCurrentLogLevel() !== logLevelComboBox.currentIndex ||
+                                             settings.getLogMaxCount() !== logMaxCountSpinBox.value || settings.getLogMaxSize() !== logMaxSizeSpinBox.value ||
+                                             settings.getLogFileFlag() !== logFileCheckBox.checked || settings.getLogCompressionFlag() !== logCompressionCheckBox.checked }
 
             // Label {
             //     text: qsTr("Path:")
@@ -77,6 +87,39 @@ ColumnLayout {
                 }
                 onActivated: saveSettingsButton.enabled = settingsColumnLayout.hasChanges()
             }
+            Label {
+                text: qsTr("Maximum log message count:")
+            }
+            SpinBox {
+                id: logMaxCountSpinBox
+                from: 100
+                to: 1000000
+                stepSize: 1000
+                editable: true
+                onValueModified: saveSettingsButton.enabled = settingsColumnLayout.hasChanges()
+            }
+            Label {
+                text: qsTr("Maximum log size, KiB:")
+            }
+            SpinBox {
+                id: logMaxSizeSpinBox
+                from: 64
+                to: 1048576
+                stepSize: 1024
+                editable: true
+                onValueModified: saveSettingsButton.enabled = settingsColumnLayout.hasChanges()
+            }
+            CheckBox {
+                id: logFileCheckBox
+                text: qsTr("Write the log to files")
+                onClicked: saveSettingsButton.enabled = settingsColumnLayout.hasChanges()
+            }
+            CheckBox {
+                id: logCompressionCheckBox
+                enabled: logFileCheckBox.checked
+                text: qsTr("Compress the old log files")
+                onClicked: saveSettingsButton.enabled = settingsColumnLayout.hasChanges()
+            }
         }
     }
 }
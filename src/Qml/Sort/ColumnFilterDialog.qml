@@ -0,0 +1,113 @@
+import QtQml
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+import "../Core" as Core
+
+Dialog {
+    anchors.centerIn: parent
+    width: parent.width - 20
+    modal: true
+    standardButtons: Dialog.Ok | Dialog.Cancel | Dialog.Reset
+    title: qsTr("Filters")
+    property var fileModel: null
+    onOpened: {
+        const fields = fileModel.getColumnFilter()
+        const textFields = [extTextField, minSizeTextField, maxSizeTextField, modifiedFromTextField, modifiedToTextField, createdFromTextField, createdToTextField]
+        for (let i = 0; i < fields.length; ++i)
+            textFields[i].text = fields[i]
+    }
+    onAccepted: {
+        if (!fileModel.setColumnFilter(extTextField.text, minSizeTextField.text, maxSizeTextField.text, modifiedFromTextField.text, modifiedToTextField.text, createdFromTextField.text, createdToTextField.text))
+            console.warn(qsTr("QML: The column filter wasn't applied, because a size or a date is incorrect"))
+    }
+    onReset: {
+        for (const textField of [extTextField, minSizeTextField, maxSizeTextField, modifiedFromTextField, modifiedToTextField, createdFromTextField, createdToTextField])
+            textField.clear()
+    }
+    background: Core.BorderRectangle {}
+    contentItem: GridLayout {
+        columns: 3
+
+        Label {
+            text: qsTr("Extensions:")
+        }
+        TextField {
+            id: extTextField
+            Layout.columnSpan: 2
+            Layout.fillWidth: true
+            placeholderText: qsTr("pdf, jpg")
+        }
+        Label {
+            text: qsTr("Size, MiB:")
+        }
+        TextField {
+            id: minSizeTextField
+            Layout.fillWidth: true
+            placeholderText: qsTr("from")
+            inputMethodHints: Qt.ImhFormattedNumbersOnly
+            validator: sizeValidator
+            onTextChanged: enableOkButton()
+        }
+        TextField {
+            id: maxSizeTextField
+            Layout.fillWidth: true
+            placeholderText: qsTr("to")
+            inputMethodHints: Qt.ImhFormattedNumbersOnly
+            validator: sizeValidator
+            onTextChanged: enableOkButton()
+        }
+        Label {
+            text: qsTr("Modified:")
+        }
+        TextField {
+            id: modifiedFromTextField
+            Layout.fillWidth: true
+            placeholderText: qsTr("YYYY-MM-DD")
+            inputMethodHints: Qt.ImhDate
+            validator: dateValidator
+            onTextChanged: enableOkButton()
+        }
+        TextField {
+            id: modifiedToTextField
+            Layout.fillWidth: true
+            placeholderText: qsTr("YYYY-MM-DD")
+            inputMethodHints: Qt.ImhDate
+            validator: dateValidator
+            onTextChanged: enableOkButton()
+        }
+        Label {
+            text: qsTr("Created:")
+        }
+        TextField {
+            id: createdFromTextField
+            Layout.fillWidth: true
+            placeholderText: qsTr("YYYY-MM-DD")
+            inputMethodHints: Qt.ImhDate
+            validator: dateValidator
+            onTextChanged: enableOkButton()
+        }
+        TextField {
+            id: createdToTextField
+            Layout.fillWidth: true
+            placeholderText: qsTr("YYYY-MM-DD")
+            inputMethodHints: Qt.ImhDate
+            validator: dateValidator
+            onTextChanged: enableOkButton()
+        }
+    }
+    function enableOkButton() {
+        const textFields = [minSizeTextField, maxSizeTextField, modifiedFromTextField, modifiedToTextField, createdFromTextField, createdToTextField]
+        standardButton(Dialog.Ok).enabled = textFields.every((textField) => textField.acceptableInput)
+    }
+
+    RegularExpressionValidator {
+        id: sizeValidator
+        regularExpression: /(\d+([.,]\d+)?)?/
+    }
+    RegularExpressionValidator {
+        id: dateValidator
+        regularExpression: /(\d{4}-\d{2}-\d{2})?/
+    }
+}
@@ -0,0 +1,111 @@
+#include "ColumnIndex.h"
+
+#include "../../FileSystem/FileSystemObject.h"
+
+using namespace Qml;
+
+bool ColumnIndex::Filter::is_active() const noexcept { return !extensions.empty() || !size.is_full() || !modification_time.is_full() || !creation_time.is_full(); }
+
+void ColumnIndex::append(int row, const FileSystemObject& obj) {
+    if (obj.is_size_valid() && obj.get_type() == FileSystemObject::Type::File) {
+        _sizes.values.push_back(obj.get_size());
+        _sizes.rows.push_back(row);
+    }
+    if (obj.is_modification_time_valid()) {
+        _modification_times.values.push_back(obj.get_modification_time().time_since_epoch().count());
+        _modification_times.rows.push_back(row);
+    }
+    if (obj.is_creation_time_valid()) {
+        _creation_times.values.push_back(obj.get_creation_time().time_since_epoch().count());
+        _creation_times.rows.push_back(row);
+    }
+    const QString ext = obj.get_extension();
+    if (!ext.isNull())
+        _extension_rows[ext].push_back(row);
+}
+
+void ColumnIndex::finish(int row_count) {
+    _row_count = row_count;
+    sort(_sizes);
+    sort(_modification_times);
+    sort(_creation_times);
+}
+
+ColumnIndex::Bitmap ColumnIndex::select(const Filter& filter) const {
+    const size_t word_count = (_row_count + 63) / 64;
+    Bitmap result(word_count, ~uint64_t(0));
+    if (_row_count % 64 != 0)
+        result.back() = (uint64_t(1) << (_row_count % 64)) - 1;
+
+    Bitmap bitmap;
+    const auto intersect = [&result, &bitmap]() {
+        for (size_t i = 0; i < result.size(); ++i)
+            result[i] &= bitmap[i];
+    };
+    if (!filter.extensions.empty()) {
+        bitmap.assign(word_count, 0);
+        for (const QString& ext : filter.extensions) {
+            const auto it = _extension_rows.find(ext);
+            if (it == std::end(_extension_rows))
+                continue;
+
+            for (const int row : it->second)
+                set(bitmap, row);
+        }
+        intersect();
+    }
+    if (!filter.size.is_full()) {
+        bitmap.assign(word_count, 0);
+        set_range(_sizes, filter.size, bitmap);
+        intersect();
+    }
+    if (!filter.modification_time.is_full()) {
+        bitmap.assign(word_count, 0);
+        set_range(_modification_times, filter.modification_time, bitmap);
+        intersect();
+    }
+    if (!filter.creation_time.is_full()) {
+        bitmap.assign(word_count, 0);
+        set_range(_creation_times, filter.creation_time, bitmap);
+        intersect();
+    }
+    return result;
+}
+
+bool ColumnIndex::contains(const Bitmap& bitmap, int row) noexcept { return (bitmap[row / 64] >> (row % 64)) & 1; }
+
+void ColumnIndex::get_rows(const Bitmap& bitmap, std::vector<int>& rows) {
+    rows.clear();
+    for (size_t i = 0; i < bitmap.size(); ++i) {
+        for (uint64_t word = bitmap[i]; word != 0; word &= word - 1)
+            rows.push_back(i * 64 + std::countr_zero(word));
+    }
+}
+
+template <typename T>
+void ColumnIndex::sort(Column<T>& column) {
+    const size_t size = column.values.size();
+    std::vector<int> order(size);
+    std::iota(std::begin(order), std::end(order), 0);
+    std::sort(std::begin(order), std::end(order), [&column](int left, int right) { return column.values[left] < column.values[right]; });
+    Column<T> sorted;
+    sorted.values.reserve(size);
+    sorted.rows.reserve(size);
+    for (const int i : order) {
+        sorted.values.push_back(column.values[i]);
+        sorted.rows.push_back(column.rows[i]);
+    }
+    column = std::move(sorted);
+}
+
+template <typename T>
+void ColumnIndex::set_range(const Column<T>& column, const Range<T>& range, Bitmap& bitmap) noexcept {
+    const auto first = std::lower_bound(std::begin(column.values), std::end(column.values), range.min);
+    const auto last = std::upper_bound(first, std::end(column.values), range.max);
+    const auto row_first = std::begin(column.rows) + (first - std::begin(column.values));
+    const auto row_last = std::begin(column.rows) + (last - std::begin(column.values));
+    for (auto it = row_first; it != row_last; ++it)
+        set(bitmap, *it);
+}
+
+void ColumnIndex::set(Bitmap& bitmap, int row) noexcept { bitmap[row / 64] |= uint64_t(1) << (row % 64); }
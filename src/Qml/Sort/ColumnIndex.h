@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include <QString>
+
+class FileSystemObject;
+
+namespace Qml {
+    class ColumnIndex {
+    public:
+        template <typename T>
+        struct Range {
+            T min = std::numeric_limits<T>::min();
+            T max = std::numeric_limits<T>::max();
+
+            bool is_full() const noexcept { return min == std::numeric_limits<T>::min() && max == std::numeric_limits<T>::max(); }
+            bool operator==(const Range& other) const = default;
+        };
+
+        struct Filter {
+            std::vector<QString> extensions; // note: The extensions are in the lower case without the dot
+            Range<uint64_t> size;
+            Range<int64_t> modification_time;
+            Range<int64_t> creation_time;
+
+            bool is_active() const noexcept;
+            bool operator==(const Filter& other) const = default;
+        };
+
+        using Bitmap = std::vector<uint64_t>;
+
+        void append(int row, const FileSystemObject& obj);
+        void finish(int row_count);
+        Bitmap select(const Filter& filter) const;
+        static bool contains(const Bitmap& bitmap, int row) noexcept;
+        static void get_rows(const Bitmap& bitmap, std::vector<int>& rows);
+
+    private:
+        template <typename T>
+        struct Column {
+            std::vector<T> values;
+            std::vector<int> rows;
+        };
+
+        template <typename T>
+        static void sort(Column<T>& column);
+        template <typename T>
+        static void set_range(const Column<T>& column, const Range<T>& range, Bitmap& bitmap) noexcept;
+        static void set(Bitmap& bitmap, int row) noexcept;
+
+    private:
+        int _row_count = 0;
+        Column<uint64_t> _sizes; // note: The columns are sorted by the values and contain only the valid ones, so a range is found by the binary search
+        Column<int64_t> _modification_times;
+        Column<int64_t> _creation_times;
+        std::unordered_map<QString, std::vector<int>> _extension_rows;
+    };
+}
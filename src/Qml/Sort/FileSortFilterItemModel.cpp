@@ -1,35 +1,123 @@
 #include "FileSortFilterItemModel.h"
 
+#include "../../FileSystem/FileSystemObject.h"
 #include "../../Json/SettingsJsonFile.h"
+#include "../../Metrics.h"
+#include "../../Trace.h"
 #include "../FileItemModel/FileItemModel.h"
-#include "../FileItemModel/Role.h"
 #include "../Util.h"
+#include "FuzzyMatcher.h"
+#include "Listing.h"
+#include "SortKeys.h"
 #include "SortParam.h"
+#include "SubstringMatcher.h"
 
 using namespace Qml;
 
+namespace {
+    bool to_size(const QString& str, uint64_t& size) {
+        if (str.trimmed().isEmpty())
+            return true;
+
+        bool ok;
+        const double mib = QString(str).replace(',', '.').trimmed().toDouble(&ok);
+        if (!ok || mib < 0)
+            return false;
+
+        size = std::llround(mib * 1024 * 1024);
+        return true;
+    }
+
+    std::vector<int> get_proxy_rows(const std::vector<int>& rows, int size) {
+        std::vector<int> proxy_rows(size, -1);
+        for (int row = 0; row < to_int(rows.size()); ++row)
+            proxy_rows[rows[row]] = row;
+
+        return proxy_rows;
+    }
+
+    bool to_time(const QString& str, bool end_of_day, int64_t& time) {
+        if (str.trimmed().isEmpty())
+            return true;
+
+        const QDate date = QDate::fromString(str.trimmed(), Qt::ISODate);
+        if (!date.isValid())
+            return false;
+
+        time = end_of_day ? date.addDays(1).startOfDay().toSecsSinceEpoch() - 1 : date.startOfDay().toSecsSinceEpoch();
+        return true;
+    }
+}
+
 FileSortFilterItemModel::FileSortFilterItemModel(std::shared_ptr<SettingsJsonFile> settings, std::unique_ptr<FileItemModel, QScopedPointerDeleteLater>&& source, QObject* parent)
-    : QSortFilterProxyModel(parent), _settings(std::move(settings)), _source(std::move(source))
+    : QAbstractProxyModel(parent), _settings(std::move(settings)), _source(std::move(source)), _guard(std::make_shared<Guard>())
 {
     qDebug().noquote() << QObject::tr("The file sort filter item model is being created");
+    _guard->model = this;
     _settings->set_notification_func([this](){ update(); });
     _params = _settings->get_sort_params();
     setSourceModel(_source.get());
-    sort(0);
+    connect(_source.get(), &QAbstractItemModel::modelAboutToBeReset, this, [this]() { beginResetModel(); });
+    connect(_source.get(), &QAbstractItemModel::modelReset, this, &FileSortFilterItemModel::update_listing);
+    beginResetModel();
+    update_listing();
     _timer.setSingleShot(true);
     const auto search = [this]() {
-        _case_sensitive = _settings->get_search_cs_flag();
-        invalidateRowsFilter();
+        const bool case_sensitive = _settings->get_search_cs_flag();
+        const bool fuzzy = _settings->get_search_fuzzy_flag();
+        const Qt::CaseSensitivity cs = case_sensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+        const auto same_mode = case_sensitive == _case_sensitive && fuzzy == _fuzzy && !_filter_text.isEmpty();
+        const auto narrow = same_mode && (fuzzy ? _text.startsWith(_filter_text, cs) : _text.contains(_filter_text, cs));
+        _case_sensitive = case_sensitive;
+        _fuzzy = fuzzy;
+        filter(narrow);
+        set_rows(get_rows()); // note: The accepted rows are picked from the sorted order, so the listing isn't sorted again
     };
     connect(&_timer, &QTimer::timeout, this, search);
 }
 
 FileSortFilterItemModel::~FileSortFilterItemModel() {
     qDebug().noquote() << QObject::tr("The file sort filter item model is being destroyed");
+    {
+        const std::lock_guard<std::mutex> locker(_guard->mutex);
+        _guard->model = nullptr; // note: A running sort job mustn't post its result to the destroyed model
+    }
     setSourceModel(nullptr);
     _settings->set_notification_func(nullptr);
 }
 
+QModelIndex FileSortFilterItemModel::index(int row, int column, const QModelIndex& parent) const {
+    if (parent.isValid() || row < 0 || row >= rowCount() || column != 0)
+        return QModelIndex();
+
+    return createIndex(row, column);
+}
+
+QModelIndex FileSortFilterItemModel::parent(const QModelIndex& /*child*/) const { return QModelIndex(); }
+
+int FileSortFilterItemModel::rowCount(const QModelIndex& parent) const { return parent.isValid() ? 0 : to_int(_rows.size()); }
+
+int FileSortFilterItemModel::columnCount(const QModelIndex& parent) const { return parent.isValid() ? 0 : 1; }
+
+bool FileSortFilterItemModel::hasChildren(const QModelIndex& parent) const { return !parent.isValid() && !_rows.empty(); }
+
+QModelIndex FileSortFilterItemModel::mapToSource(const QModelIndex& proxy_index) const {
+    if (!proxy_index.isValid())
+        return QModelIndex();
+
+    assert(to_type<size_t>(proxy_index.row()) < _rows.size());
+    return _source->index(_rows[proxy_index.row()], proxy_index.column());
+}
+
+QModelIndex FileSortFilterItemModel::mapFromSource(const QModelIndex& source_index) const {
+    if (!source_index.isValid())
+        return QModelIndex();
+
+    assert(to_type<size_t>(source_index.row()) < _proxy_rows.size());
+    const int row = _proxy_rows[source_index.row()];
+    return row < 0 ? QModelIndex() : createIndex(row, source_index.column());
+}
+
 void FileSortFilterItemModel::search(const QString& text) {
     if (_text == text)
         return;
@@ -51,45 +139,280 @@ void FileSortFilterItemModel::repeatSearch(int msec) {
     _timer.start(msec);
 }
 
-bool FileSortFilterItemModel::filterAcceptsRow(int source_row, const QModelIndex& source_parent) const {
-    if (_text.isEmpty())
+bool FileSortFilterItemModel::setColumnFilter(const QString& extensions, const QString& min_size, const QString& max_size, const QString& modified_from, const QString& modified_to, const QString& created_from, const QString& created_to) {
+    ColumnIndex::Filter column_filter;
+    static const QRegularExpression separator(QStringLiteral("[\\s,;]+"));
+    for (const QString& ext : extensions.split(separator, Qt::SkipEmptyParts)) {
+        const QString lower_ext = (ext.startsWith('.') ? ext.sliced(1) : ext).toLower();
+        if (!lower_ext.isEmpty())
+            column_filter.extensions.push_back(lower_ext);
+    }
+    const auto ok = to_size(min_size, column_filter.size.min) && to_size(max_size, column_filter.size.max) &&
+                    to_time(modified_from, false, column_filter.modification_time.min) && to_time(modified_to, true, column_filter.modification_time.max) &&
+                    to_time(created_from, false, column_filter.creation_time.min) && to_time(created_to, true, column_filter.creation_time.max);
+    if (!ok)
+        return false;
+
+    _column_filter_fields = {extensions, min_size, max_size, modified_from, modified_to, created_from, created_to};
+    if (_column_filter == column_filter)
         return true;
 
-    const QModelIndex index = sourceModel()->index(source_row, 0, source_parent);
-    auto role = to_int(FileItemModelRole::IsExit);
-    assert(index.data(role).canConvert<bool>());
-    if (index.data(role).toBool())
-        return false;
+    _column_filter = std::move(column_filter);
+    filter(false); // note: The rows rejected by the previous column filter can be accepted now, so the narrowing isn't possible
+    set_rows(get_rows());
+    return true;
+}
 
-    role = to_int(FileItemModelRole::Name);
-    assert(index.data(role).canConvert<QString>());
-    const auto name = index.data(to_int(FileItemModelRole::Name)).toString();
-    return name.indexOf(_text, 0, _case_sensitive ? Qt::CaseSensitive : Qt::CaseInsensitive) != -1;
-}
-
-bool FileSortFilterItemModel::lessThan(const QModelIndex& source_left, const QModelIndex& source_right) const {
-    using Role = FileItemModelRole;
-    const QVariant left_data = source_left.data(to_int(Role::IsExit));
-    const QVariant right_data = source_right.data(to_int(Role::IsExit));
-    assert(left_data.canConvert<bool>());
-    assert(right_data.canConvert<bool>());
-    const auto left_is_exit = left_data.toBool();
-    if (left_is_exit || right_data.toBool())
-        return left_is_exit;
-
-    assert(!_params.empty());
-    for (const auto& param : _params) {
-        const QVariant left_data = source_left.data(to_int(param.role));
-        const QVariant right_data = source_right.data(to_int(param.role));
-        assert(param.comp_func);
-        const SortParam::CompResult result = param.comp_func(left_data, right_data, param.descending);
-        if (result != SortParam::CompResult::Equal)
-            return result == SortParam::CompResult::Less;
+QStringList FileSortFilterItemModel::getColumnFilter() const { return _column_filter_fields; }
+
+bool FileSortFilterItemModel::hasColumnFilter() const { return _column_filter.is_active(); }
+
+FileSortFilterItemModel::Sorted FileSortFilterItemModel::get_sorted(const FileItemModel::Snapshot& snapshot, Sorted&& sorted, bool natural, const std::vector<SortParam>& params, QThreadPool* pool) {
+    if (sorted.listing == nullptr)
+        sorted.listing = std::make_shared<const Listing>(snapshot);
+
+    if (sorted.sort_keys == nullptr) {
+        const auto sort_keys = std::make_shared<SortKeys>(natural);
+        const int size = snapshot.size();
+        sort_keys->reserve(size);
+        for (int row = 0; row < size; ++row)
+            sort_keys->append(snapshot.get_object(row));
+
+        sorted.sort_keys = sort_keys;
     }
-    return false;
+    sorted.order = sorted.sort_keys->get_order(params, pool); // note: The sort keys are compared only once per listing and sort parameters, the filters pick the accepted rows from the order
+    return sorted;
 }
 
 void FileSortFilterItemModel::update() {
     _params = _settings->get_sort_params();
-    invalidate();
+    if (_sort_keys != nullptr && _sort_keys->is_natural() != _settings->get_natural_sort_flag())
+        _sort_keys.reset(); // note: The natural order needs the segmented name keys, so they are rebuilt with the order
+
+    if (start_sort())
+        set_rows(get_rows());
+}
+
+void FileSortFilterItemModel::update_listing() { // note: Follows beginResetModel(), which is called when the source model is about to be reset
+    const Trace::Span span("FileSortFilterItemModel::update_listing");
+    _snapshot = _source->get_snapshot();
+    _listing.reset();
+    _sort_keys.reset();
+    _order.clear(); // note: The order of the previous listing is never applied to this one, even if the row count is the same
+    start_sort();
+    _rows = get_rows();
+    _proxy_rows = get_proxy_rows(_rows, _snapshot.size());
+    endResetModel();
+}
+
+bool FileSortFilterItemModel::start_sort() {
+    ++_sort_generation;
+    Sorted sorted{_listing, _sort_keys, {}};
+    const bool natural = _settings->get_natural_sort_flag();
+    if (_snapshot.size() < SortKeys::parallel_threshold) {
+        const Trace::Span span("FileSortFilterItemModel::get_sorted");
+        store_sorted(get_sorted(_snapshot, std::move(sorted), natural, _params, nullptr));
+        return true;
+    }
+    const auto job = [guard = _guard, snapshot = _snapshot, sorted = std::move(sorted), natural, params = _params, generation = _sort_generation]() mutable {
+        const int64_t start = Trace::start();
+        Sorted result = get_sorted(snapshot, std::move(sorted), natural, params, &guard->sort_pool); // note: The listing and the sort keys are built here too, so the GUI thread only picks the rows
+        Trace::finish("FileSortFilterItemModel::get_sorted (parallel)", start);
+        const std::lock_guard<std::mutex> locker(guard->mutex);
+        if (guard->model == nullptr)
+            return;
+
+        const auto install = [model = guard->model, result = std::move(result), generation]() mutable { model->install_sorted(std::move(result), generation); };
+        QMetaObject::invokeMethod(guard->model, std::move(install), Qt::QueuedConnection);
+    };
+    QThreadPool::globalInstance()->start(job);
+    return false;
+}
+
+void FileSortFilterItemModel::store_sorted(Sorted&& sorted) {
+    const bool new_listing = sorted.listing != _listing;
+    _listing = std::move(sorted.listing);
+    _sort_keys = std::move(sorted.sort_keys);
+    _order = std::move(sorted.order);
+    if (new_listing)
+        filter(false); // note: The text and the column filter could be changed while the listing was built
+}
+
+void FileSortFilterItemModel::install_sorted(Sorted&& sorted, uint64_t generation) {
+    const Trace::Span span("FileSortFilterItemModel::install_sorted");
+    if (generation != _sort_generation)
+        return; // note: The listing or the sort parameters have been changed since the job started
+
+    store_sorted(std::move(sorted));
+    set_rows(get_rows());
+}
+
+std::vector<int> FileSortFilterItemModel::get_rows() const {
+    std::vector<int> rows;
+    if (_listing == nullptr) {
+        if (_text.isEmpty() && !_column_filter.is_active()) { // note: The rows keep the source order until the sorted listing is installed
+            rows.resize(_snapshot.size());
+            std::iota(std::begin(rows), std::end(rows), 0);
+        }
+        return rows;
+    }
+    rows.reserve(_accepted_rows.empty() ? _order.size() : _accepted_rows.size());
+    for (const int row : _order) {
+        if (!_accepted[row])
+            continue;
+
+        if (_listing->is_exit(row))
+            rows.insert(std::begin(rows), row); // note: The exit row is always the first
+        else
+            rows.push_back(row);
+    }
+    if (is_ranked()) // note: The scores are the primary sort key, the stable sort keeps the order of the rows with the same score
+        std::stable_sort(std::begin(rows), std::end(rows), [this](int left, int right) { return _scores[left] > _scores[right]; });
+
+    return rows;
+}
+
+void FileSortFilterItemModel::set_rows(std::vector<int>&& rows) {
+    const Trace::Span span("FileSortFilterItemModel::set_rows");
+    std::vector<int> proxy_rows = get_proxy_rows(rows, _snapshot.size());
+    size_t kept_count = 0;
+    int prev_row = -1;
+    bool ordered = true;
+    for (const int source_row : _rows) {
+        const int row = proxy_rows[source_row];
+        if (row < 0)
+            continue;
+
+        ordered = ordered && row > prev_row;
+        prev_row = row;
+        ++kept_count;
+    }
+    const bool same_rows = kept_count == _rows.size() && kept_count == rows.size();
+    if (!ordered)
+        change_layout(std::move(rows), std::move(proxy_rows), same_rows ? QAbstractItemModel::VerticalSortHint : QAbstractItemModel::NoLayoutChangeHint);
+    else if (!same_rows)
+        change_rows(std::move(rows), std::move(proxy_rows)); // note: The kept rows are in the same order, so only the rejected rows are removed and the accepted ones are inserted
+}
+
+void FileSortFilterItemModel::change_layout(std::vector<int>&& rows, std::vector<int>&& proxy_rows, QAbstractItemModel::LayoutChangeHint hint) {
+    emit layoutAboutToBeChanged({}, hint);
+    const QModelIndexList from = persistentIndexList();
+    QModelIndexList to;
+    to.reserve(from.size());
+    for (const QModelIndex& index : from) {
+        const int row = proxy_rows[_rows[index.row()]];
+        to.push_back(row < 0 ? QModelIndex() : createIndex(row, index.column()));
+    }
+    _rows = std::move(rows);
+    _proxy_rows = std::move(proxy_rows);
+    changePersistentIndexList(from, to);
+    emit layoutChanged({}, hint);
 }
+
+void FileSortFilterItemModel::change_rows(std::vector<int>&& rows, std::vector<int>&& proxy_rows) {
+    for (int last = to_int(_rows.size()) - 1; last >= 0;) { // note: The ranges are removed from the end, so the rows before them aren't shifted
+        if (proxy_rows[_rows[last]] >= 0) {
+            --last;
+            continue;
+        }
+        int first = last;
+        while (first > 0 && proxy_rows[_rows[first - 1]] < 0)
+            --first;
+
+        beginRemoveRows(QModelIndex(), first, last);
+        _rows.erase(std::begin(_rows) + first, std::begin(_rows) + last + 1);
+        endRemoveRows();
+        last = first - 1;
+    }
+    const int size = rows.size();
+    for (int first = 0, pos = 0; first < size;) {
+        if (to_type<size_t>(pos) < _rows.size() && _rows[pos] == rows[first]) {
+            ++first;
+            ++pos;
+            continue;
+        }
+        int last = first + 1;
+        while (last < size && (to_type<size_t>(pos) == _rows.size() || _rows[pos] != rows[last]))
+            ++last;
+
+        beginInsertRows(QModelIndex(), pos, pos + last - first - 1);
+        _rows.insert(std::begin(_rows) + pos, std::begin(rows) + first, std::begin(rows) + last);
+        endInsertRows();
+        pos += last - first;
+        first = last;
+    }
+    assert(_rows == rows);
+    _proxy_rows = std::move(proxy_rows);
+}
+
+void FileSortFilterItemModel::filter(bool narrow) {
+    const Trace::Span span("FileSortFilterItemModel::filter");
+    static const auto metrics = Metrics::get_instance();
+    static Metrics::Counter& narrowing_hits = metrics->get_counter(QStringLiteral("filter.narrowing_hits"));
+    static Metrics::Counter& narrowing_misses = metrics->get_counter(QStringLiteral("filter.narrowing_misses"));
+    if (_listing == nullptr)
+        return; // note: The listing is filtered, when the sort job installs it
+
+    (narrow ? narrowing_hits : narrowing_misses).add(); // note: A hit reuses the rows accepted by the previous text instead of scanning the whole listing
+    const int size = _listing->size();
+    _filter_text = _text;
+    const bool filter_columns = _column_filter.is_active();
+    if (_text.isEmpty() && !filter_columns) {
+        _accepted.assign(size, true);
+        _accepted_rows.clear();
+        return;
+    }
+    if (!_text.isEmpty()) {
+        if (_fuzzy)
+            filter_fuzzy(narrow);
+        else
+            filter_substring(narrow);
+    }
+    if (filter_columns) {
+        const ColumnIndex::Bitmap bitmap = _listing->get_columns().select(_column_filter); // note: The ranges are found by the binary search in the sorted columns, then the row sets are intersected as bitmaps
+        if (_text.isEmpty()) {
+            ColumnIndex::get_rows(bitmap, _accepted_rows);
+        } else {
+            const auto rejected = [&bitmap](int row) { return !ColumnIndex::contains(bitmap, row); };
+            _accepted_rows.erase(std::remove_if(std::begin(_accepted_rows), std::end(_accepted_rows), rejected), std::end(_accepted_rows));
+        }
+    }
+    _accepted.assign(size, false);
+    for (const int row : _accepted_rows)
+        _accepted[row] = true;
+}
+
+void FileSortFilterItemModel::filter_substring(bool narrow) {
+    const SubstringMatcher matcher(_case_sensitive ? _text : _text.toCaseFolded());
+    const SubstringMatcher::Pool& names = _case_sensitive ? _listing->get_names() : _listing->get_folded_names();
+    if (narrow)
+        matcher.narrow(names, _accepted_rows); // note: Only the rows accepted by the previous text can match the text, which contains it
+    else
+        matcher.find_all(names, _accepted_rows);
+
+    if (!_accepted_rows.empty() && _listing->is_exit(_accepted_rows.front()))
+        _accepted_rows.erase(std::begin(_accepted_rows));
+}
+
+void FileSortFilterItemModel::filter_fuzzy(bool narrow) {
+    const int size = _listing->size();
+    if (!narrow) {
+        _accepted_rows.resize(size);
+        std::iota(std::begin(_accepted_rows), std::end(_accepted_rows), 0);
+    }
+    const FuzzyMatcher matcher(_case_sensitive ? _text : _text.toCaseFolded());
+    const SubstringMatcher::Pool& names = _listing->get_names();
+    const SubstringMatcher::Pool& matched_names = _case_sensitive ? names : _listing->get_folded_names();
+    _scores.assign(size, 0);
+    const auto mismatches = [this, &matcher, &names, &matched_names](int row) {
+        if (_listing->is_exit(row) || !matcher.may_match(_listing->get_char_mask(row)))
+            return true;
+
+        const int score = matcher.score(matched_names.get(row), names.get(row));
+        _scores[row] = score;
+        return score == 0;
+    };
+    _accepted_rows.erase(std::remove_if(std::begin(_accepted_rows), std::end(_accepted_rows), mismatches), std::end(_accepted_rows)); // note: Only the rows accepted by the previous text can match the text, which starts with it
+}
+
+bool FileSortFilterItemModel::is_ranked() const noexcept { return _fuzzy && !_filter_text.isEmpty(); }
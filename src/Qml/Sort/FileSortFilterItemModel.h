@@ -1,46 +1,102 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <vector>
 
+#include <QAbstractProxyModel>
 #include <QModelIndex>
 #include <QObject>
 #include <QScopedPointer>
 #include <QString>
-#include <QSortFilterProxyModel>
+#include <QStringList>
+#include <QThreadPool>
 #include <QTimer>
 
+#include "../FileItemModel/FileItemModel.h"
+#include "ColumnIndex.h"
+
 class SettingsJsonFile;
 
 namespace Qml {
-    class FileItemModel;
+    class Listing;
+    class SortKeys;
     class SortParam;
 
-    class FileSortFilterItemModel : public QSortFilterProxyModel {
+    class FileSortFilterItemModel : public QAbstractProxyModel {
         Q_OBJECT
 
     public:
         FileSortFilterItemModel(std::shared_ptr<SettingsJsonFile> settings, std::unique_ptr<FileItemModel, QScopedPointerDeleteLater>&& source, QObject* parent = nullptr);
         ~FileSortFilterItemModel() override;
 
+        QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex parent(const QModelIndex& child) const override;
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+        bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex mapToSource(const QModelIndex& proxy_index) const override;
+        QModelIndex mapFromSource(const QModelIndex& source_index) const override;
+
         Q_INVOKABLE void search(const QString& text);
         Q_INVOKABLE void searchWithTimer(const QString& text);
         Q_INVOKABLE void repeatSearch(int msec);
-
-    protected:
-        bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const override;
-        bool lessThan(const QModelIndex& source_left, const QModelIndex& source_right) const override;
+        Q_INVOKABLE bool setColumnFilter(const QString& extensions, const QString& min_size, const QString& max_size, const QString& modified_from, const QString& modified_to, const QString& created_from, const QString& created_to);
+        Q_INVOKABLE QStringList getColumnFilter() const;
+        Q_INVOKABLE bool hasColumnFilter() const;
 
     private:
+        struct Guard {
+            std::mutex mutex;
+            FileSortFilterItemModel* model = nullptr;
+            QThreadPool sort_pool; // note: Every sort job holds the guard, so the pool outlives the jobs, which use it, even after the model is destroyed. The sort tasks wait for each other, so they don't share the global pool with the job, which waits for them
+        };
+
+        struct Sorted {
+            std::shared_ptr<const Listing> listing;
+            std::shared_ptr<const SortKeys> sort_keys;
+            std::vector<int> order;
+        };
+
+        static Sorted get_sorted(const FileItemModel::Snapshot& snapshot, Sorted&& sorted, bool natural, const std::vector<SortParam>& params, QThreadPool* pool);
+
         void update();
+        void update_listing();
+        bool start_sort();
+        void store_sorted(Sorted&& sorted);
+        void install_sorted(Sorted&& sorted, uint64_t generation);
+        std::vector<int> get_rows() const;
+        void set_rows(std::vector<int>&& rows);
+        void change_layout(std::vector<int>&& rows, std::vector<int>&& proxy_rows, QAbstractItemModel::LayoutChangeHint hint);
+        void change_rows(std::vector<int>&& rows, std::vector<int>&& proxy_rows);
+        void filter(bool narrow);
+        void filter_substring(bool narrow);
+        void filter_fuzzy(bool narrow);
+        bool is_ranked() const noexcept;
 
     private:
         std::shared_ptr<SettingsJsonFile> _settings;
         std::unique_ptr<FileItemModel, QScopedPointerDeleteLater> _source;
 
         std::vector<SortParam> _params;
+        FileItemModel::Snapshot _snapshot;
+        std::shared_ptr<const Listing> _listing;
+        std::shared_ptr<const SortKeys> _sort_keys;
+        std::vector<int> _order;
+        std::shared_ptr<Guard> _guard;
+        uint64_t _sort_generation = 0;
+        std::vector<int> _rows;
+        std::vector<int> _proxy_rows; // note: -1 for a source row rejected by the filter
+        std::vector<bool> _accepted;
+        std::vector<int> _accepted_rows;
+        std::vector<int> _scores;
+        ColumnIndex::Filter _column_filter;
+        QStringList _column_filter_fields;
         QTimer _timer;
         QString _text;
-        bool _case_sensitive;
+        QString _filter_text;
+        bool _case_sensitive = false;
+        bool _fuzzy = false;
     };
 }
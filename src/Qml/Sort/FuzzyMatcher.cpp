@@ -0,0 +1,140 @@
+#include "FuzzyMatcher.h"
+
+using namespace Qml;
+
+FuzzyMatcher::FuzzyMatcher(const QStringView& text) : _tokens(get_tokens(text)), _char_mask(get_char_mask(_tokens)) { assert(!text.isEmpty()); }
+
+uint64_t FuzzyMatcher::get_char_mask(const QStringView& folded_str) noexcept {
+    uint64_t mask = 0;
+    for (const QChar ch : folded_str) {
+        const char16_t code = ch.unicode();
+        int bit;
+        if (code >= 'a' && code <= 'z')
+            bit = code - 'a';
+        else if (code >= '0' && code <= '9')
+            bit = 26 + code - '0';
+        else
+            bit = 36 + code % 28; // note: The rest characters share the remaining bits, so the mask may only let a non-candidate through
+        mask |= uint64_t(1) << bit;
+    }
+    return mask;
+}
+
+bool FuzzyMatcher::may_match(uint64_t char_mask) const noexcept { return (_char_mask & ~char_mask) == 0; }
+
+int FuzzyMatcher::score(const QStringView& str, const QStringView& original) const noexcept {
+    if (_tokens.empty())
+        return 1; // note: A text of only spaces matches every name, so the text typed after it narrows all rows
+
+    int score = 0;
+    for (const QString& token : _tokens) {
+        const int token_score = get_token_score(token, str, original);
+        if (token_score == 0)
+            return 0;
+
+        score += token_score;
+    }
+    return score;
+}
+
+std::vector<QString> FuzzyMatcher::get_tokens(const QStringView& text) {
+    std::vector<QString> tokens;
+    qsizetype start = -1;
+    for (qsizetype i = 0, size = text.size(); i <= size; ++i) {
+        if (i == size || text[i].isSpace()) {
+            if (start != -1)
+                tokens.push_back(text.mid(start, i - start).toString());
+
+            start = -1;
+        } else if (start == -1) {
+            start = i;
+        }
+    }
+    return tokens;
+}
+
+uint64_t FuzzyMatcher::get_char_mask(const std::vector<QString>& tokens) {
+    uint64_t mask = 0;
+    for (const QString& token : tokens)
+        mask |= get_char_mask(token.toCaseFolded()); // note: The masks of the names are computed from the folded names
+
+    return mask;
+}
+
+int FuzzyMatcher::get_token_score(const QString& token, const QStringView& str, const QStringView& original) noexcept {
+    const qsizetype size = str.size();
+    const qsizetype text_size = token.size();
+    qsizetype j = 0;
+    qsizetype end = -1;
+    for (qsizetype i = 0; i < size; ++i) {
+        if (str[i] == token[j] && ++j == text_size) {
+            end = i + 1;
+            break;
+        }
+    }
+    if (end == -1)
+        return 0;
+
+    qsizetype start = end - 1;
+    for (j = text_size; ; --start) { // note: The backward scan finds the shortest window, which ends at the found position
+        if (str[start] == token[j - 1] && --j == 0)
+            break;
+    }
+    const QStringView& classes = original.size() == size ? original : str;
+    CharClass prev = start == 0 ? CharClass::NonWord : get_class(classes[start - 1]);
+    int score = 0;
+    int first_bonus = 0;
+    auto consecutive = false;
+    auto in_gap = false;
+    j = 0;
+    for (qsizetype i = start; i < end; ++i) {
+        const CharClass curr = get_class(classes[i]);
+        if (j < text_size && str[i] == token[j]) {
+            int bonus = get_bonus(prev, curr);
+            if (!consecutive) {
+                first_bonus = bonus;
+            } else {
+                if (bonus >= _bonus_boundary && bonus > first_bonus)
+                    first_bonus = bonus;
+
+                bonus = std::max({bonus, first_bonus, _bonus_consecutive});
+            }
+            score += _score_match + (j == 0 ? bonus * _bonus_first_char_multiplier : bonus);
+            consecutive = true;
+            in_gap = false;
+            ++j;
+        } else {
+            score += in_gap ? _score_gap_extension : _score_gap_start;
+            consecutive = false;
+            in_gap = true;
+        }
+        prev = curr;
+    }
+    return std::max(score, 1);
+}
+
+FuzzyMatcher::CharClass FuzzyMatcher::get_class(QChar ch) noexcept {
+    if (ch.isLower())
+        return CharClass::Lower;
+
+    if (ch.isUpper())
+        return CharClass::Upper;
+
+    if (ch.isDigit())
+        return CharClass::Digit;
+
+    return ch.isLetter() ? CharClass::Lower : CharClass::NonWord;
+}
+
+int FuzzyMatcher::get_bonus(CharClass prev, CharClass curr) noexcept {
+    if (curr == CharClass::NonWord)
+        return _bonus_non_word;
+
+    if (prev == CharClass::NonWord)
+        return _bonus_boundary;
+
+    if ((prev == CharClass::Lower && curr == CharClass::Upper) || (prev != CharClass::Digit && curr == CharClass::Digit))
+        return _bonus_camel_case;
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <QChar>
+#include <QString>
+#include <QStringView>
+
+namespace Qml {
+    class FuzzyMatcher {
+    public:
+        explicit FuzzyMatcher(const QStringView& text);
+
+        static uint64_t get_char_mask(const QStringView& folded_str) noexcept;
+        bool may_match(uint64_t char_mask) const noexcept;
+        int score(const QStringView& str, const QStringView& original) const noexcept;
+
+    private:
+        enum class CharClass {NonWord, Lower, Upper, Digit};
+
+        static std::vector<QString> get_tokens(const QStringView& text);
+        static uint64_t get_char_mask(const std::vector<QString>& tokens);
+        static int get_token_score(const QString& token, const QStringView& str, const QStringView& original) noexcept;
+        static CharClass get_class(QChar ch) noexcept;
+        static int get_bonus(CharClass prev, CharClass curr) noexcept;
+
+    private:
+        constexpr static int _score_match = 16;
+        constexpr static int _score_gap_start = -3;
+        constexpr static int _score_gap_extension = -1;
+        constexpr static int _bonus_boundary = _score_match / 2;
+        constexpr static int _bonus_non_word = _score_match / 2;
+        constexpr static int _bonus_camel_case = _bonus_boundary - 1;
+        constexpr static int _bonus_consecutive = -(_score_gap_start + _score_gap_extension);
+        constexpr static int _bonus_first_char_multiplier = 2;
+
+        const std::vector<QString> _tokens; // note: The words of the text, which are matched independently of each other, so "2024 report" matches "Report_2024.pdf"
+        const uint64_t _char_mask;
+    };
+}
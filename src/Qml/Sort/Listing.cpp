@@ -0,0 +1,48 @@
+#include "Listing.h"
+
+#include "../../FileSystem/FileSystemObject.h"
+#include "FuzzyMatcher.h"
+
+using namespace Qml;
+
+Listing::Listing(const FileItemModel::Snapshot& snapshot) {
+    const int size = snapshot.size();
+    std::vector<QString> names;
+    names.reserve(size);
+    size_t char_count = 0;
+    for (int row = 0; row < size; ++row) {
+        if (snapshot.is_exit(row)) {
+            _exit_row = row;
+            names.emplace_back(QStringLiteral(".."));
+        } else {
+            const FileSystemObject& obj = snapshot.get_object(row);
+            names.emplace_back(obj.get_name());
+            _columns.append(row, obj);
+        }
+        char_count += names.back().size();
+    }
+    _names.reserve(size, char_count);
+    _folded_names.reserve(size, char_count);
+    _char_masks.reserve(size);
+    for (const QString& name : names) {
+        const QString folded_name = name.toCaseFolded();
+        _names.append(name);
+        _folded_names.append(folded_name);
+        _char_masks.push_back(FuzzyMatcher::get_char_mask(folded_name));
+    }
+    _names.finish();
+    _folded_names.finish();
+    _columns.finish(size);
+}
+
+int Listing::size() const noexcept { return _names.size(); }
+
+bool Listing::is_exit(int row) const noexcept { return row == _exit_row; }
+
+const SubstringMatcher::Pool& Listing::get_names() const noexcept { return _names; }
+
+const SubstringMatcher::Pool& Listing::get_folded_names() const noexcept { return _folded_names; }
+
+uint64_t Listing::get_char_mask(int row) const noexcept { return _char_masks[row]; }
+
+const ColumnIndex& Listing::get_columns() const noexcept { return _columns; }
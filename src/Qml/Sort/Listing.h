@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../FileItemModel/FileItemModel.h"
+#include "ColumnIndex.h"
+#include "SubstringMatcher.h"
+
+namespace Qml {
+    class Listing {
+    public:
+        explicit Listing(const FileItemModel::Snapshot& snapshot);
+
+        int size() const noexcept;
+        bool is_exit(int row) const noexcept;
+        const SubstringMatcher::Pool& get_names() const noexcept;
+        const SubstringMatcher::Pool& get_folded_names() const noexcept;
+        uint64_t get_char_mask(int row) const noexcept;
+        const ColumnIndex& get_columns() const noexcept;
+
+    private:
+        SubstringMatcher::Pool _names;
+        SubstringMatcher::Pool _folded_names;
+        std::vector<uint64_t> _char_masks;
+        ColumnIndex _columns;
+        int _exit_row = -1;
+    };
+}
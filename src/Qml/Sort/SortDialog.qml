@@ -10,12 +10,13 @@ import WebDavClient
 Dialog {
     anchors.centerIn: parent
     width: parent.width - 20
-    height: 370 // todo: find a solution to resize to the content
+    height: 410 // todo: find a solution to resize to the content
     modal: true
     standardButtons: Dialog.Ok | Dialog.Cancel
     title: qsTr("Sort parameters")
     onOpened: {
         listView.model = itemModelManager.createModel(ItemModel.SortParam)
+        naturalCheckBox.checkState = listView.model.getNaturalFlag() ? Qt.Checked : Qt.Unchecked
         enableEditButtons()
         enableOkButton()
     }
@@ -95,6 +96,13 @@ Dialog {
                 Layout.alignment: Qt.AlignHCenter
                 text: qsTr("Lower priority")
             }
+            CheckBox {
+                id: naturalCheckBox
+                leftPadding: 0
+                rightPadding: 0
+                text: qsTr("Natural order of numbers in names")
+                onClicked: { listView.model.setNaturalFlag(checked); enableOkButton() }
+            }
         }
         Column {
             spacing: 5
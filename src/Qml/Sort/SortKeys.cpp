@@ -0,0 +1,338 @@
+#include "SortKeys.h"
+
+#include "../../FileSystem/FileSystemObject.h"
+#include "SortParam.h"
+
+using namespace Qml;
+
+namespace Qml {
+    using Role = FileItemModelRole;
+}
+
+namespace {
+    template <typename T>
+    constexpr int compare_values(const T& left, const T& right) noexcept { return left < right ? -1 : (right < left ? 1 : 0); }
+}
+
+SortKeys::SortKeys(bool natural) : _empty_key(_collator.sortKey(QString())), _natural(natural) {
+    if (_natural)
+        _segment_offsets.push_back(0);
+}
+
+void SortKeys::reserve(int size) {
+    _keys.reserve(size);
+    _name_keys.reserve(size);
+    _extension_keys.reserve(size);
+    if (_natural)
+        _segment_offsets.reserve(size + 1);
+}
+
+void SortKeys::append(const FileSystemObject& obj) {
+    Key key{};
+    if (obj.get_type() == FileSystemObject::Type::File)
+        key.flags |= File;
+
+    if (obj.is_creation_time_valid()) {
+        key.creation_time = obj.get_creation_time().time_since_epoch().count();
+        key.flags |= CreationTimeValid;
+    }
+    if (obj.is_modification_time_valid()) {
+        key.modification_time = obj.get_modification_time().time_since_epoch().count();
+        key.flags |= ModificationTimeValid;
+    }
+    if (obj.is_size_valid()) {
+        key.size = obj.get_size();
+        key.flags |= SizeValid;
+    }
+    const QString ext = obj.get_extension();
+    if (!ext.isNull())
+        key.flags |= ExtensionValid;
+
+    _keys.push_back(key);
+    _name_keys.push_back(_collator.sortKey(obj.get_name()));
+    _extension_keys.push_back(ext.isNull() ? _empty_key : _collator.sortKey(ext));
+    if (_natural)
+        append_segments(obj.get_name());
+}
+
+int SortKeys::size() const noexcept { return _keys.size(); }
+
+bool SortKeys::is_natural() const noexcept { return _natural; }
+
+std::vector<int> SortKeys::get_order(const std::vector<SortParam>& params, QThreadPool* pool) const {
+    const int size = _keys.size();
+    std::vector<int> order(size);
+    std::iota(std::begin(order), std::end(order), 0);
+    auto param_it = std::begin(params);
+    const auto param_end = std::end(params);
+    std::array<Iterator, 3> bounds{std::begin(order), std::end(order), std::end(order)};
+    if (param_it != param_end && param_it->role == Role::FileFlag) { // note: The type has two values, so the stable partition replaces the sort by it
+        const auto descending = param_it->descending;
+        bounds[1] = std::stable_partition(std::begin(order), std::end(order), [this, descending](int row) { return ((_keys[row].flags & File) != 0) == descending; });
+        ++param_it;
+    }
+    if (param_it != param_end) {
+        const auto next_it = param_it + 1;
+        Tie tie = Tie::Generic;
+        if (next_it != param_end && next_it->role == Role::Name)
+            tie = next_it->descending ? Tie::NameDescending : Tie::NameAscending;
+
+        const SortFunc sort_func = get_sort_func(param_it->role, param_it->descending, tie);
+        const MergeFunc merge_func = get_merge_func(param_it->role, param_it->descending, tie);
+        Tail tail;
+        for (++param_it; param_it != param_end; ++param_it) {
+            assert(tail.size < tail.funcs.size());
+            tail.funcs[tail.size++] = get_compare_func(param_it->role, param_it->descending);
+        }
+        for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+            if (pool != nullptr && bounds[i + 1] - bounds[i] >= parallel_threshold)
+                sort_in_parallel(bounds[i], bounds[i + 1], sort_func, merge_func, tail, *pool);
+            else
+                (this->*sort_func)(bounds[i], bounds[i + 1], tail);
+        }
+    }
+    return order;
+}
+
+template <FileItemModelRole role>
+int SortKeys::compare_ascending(int left, int right) const noexcept {
+    const Key& left_key = _keys[left];
+    const Key& right_key = _keys[right];
+    if constexpr (role == Role::FileFlag) {
+        return compare_values(left_key.flags & File, right_key.flags & File);
+    } else if constexpr (role == Role::Name) {
+        const int result = _natural ? compare_segments(left, right) : 0;
+        return result != 0 ? result : _name_keys[left].compare(_name_keys[right]); // note: The whole name breaks the ties like "file01" and "file1"
+    } else if constexpr (role == Role::Extension) {
+        const int result = compare_if_valid(ExtensionValid, left, right);
+        return result != 0 || (left_key.flags & ExtensionValid) == 0 ? result : _extension_keys[left].compare(_extension_keys[right]);
+    } else if constexpr (role == Role::CreationTime) {
+        const int result = compare_if_valid(CreationTimeValid, left, right);
+        return result != 0 || (left_key.flags & CreationTimeValid) == 0 ? result : compare_values(left_key.creation_time, right_key.creation_time);
+    } else if constexpr (role == Role::ModTime) {
+        const int result = compare_if_valid(ModificationTimeValid, left, right);
+        return result != 0 || (left_key.flags & ModificationTimeValid) == 0 ? result : compare_values(left_key.modification_time, right_key.modification_time);
+    } else {
+        static_assert(role == Role::Size);
+        const int result = compare_if_valid(SizeValid, left, right);
+        return result != 0 || (left_key.flags & SizeValid) == 0 ? result : compare_values(left_key.size, right_key.size);
+    }
+}
+
+template <FileItemModelRole role, bool descending>
+int SortKeys::compare_key(const SortKeys& keys, int left, int right) noexcept {
+    const int result = keys.compare_ascending<role>(left, right);
+    return descending ? -result : result;
+}
+
+template <FileItemModelRole role, bool descending, SortKeys::Tie tie>
+bool SortKeys::is_less(int left, int right, const Tail& tail) const noexcept {
+    const int result = compare_key<role, descending>(*this, left, right); // note: The first key is inlined, the rest keys are compared only on ties
+    if (result != 0)
+        return result < 0;
+
+    size_t i = 0;
+    if constexpr (tie != Tie::Generic) {
+        const int tie_result = compare_key<Role::Name, tie == Tie::NameDescending>(*this, left, right); // note: Replaces the first function of the tail
+        if (tie_result != 0)
+            return tie_result < 0;
+
+        i = 1;
+    }
+    for (; i < tail.size; ++i) {
+        const int tail_result = tail.funcs[i](*this, left, right);
+        if (tail_result != 0)
+            return tail_result < 0;
+    }
+    return false;
+}
+
+template <FileItemModelRole role, bool descending, SortKeys::Tie tie>
+void SortKeys::sort(Iterator first, Iterator last, const Tail& tail) const {
+    std::stable_sort(first, last, [this, &tail](int left, int right) { return is_less<role, descending, tie>(left, right, tail); });
+}
+
+template <FileItemModelRole role, bool descending, SortKeys::Tie tie>
+void SortKeys::merge(Iterator first, Iterator middle, Iterator last, const Tail& tail) const {
+    std::inplace_merge(first, middle, last, [this, &tail](int left, int right) { return is_less<role, descending, tie>(left, right, tail); });
+}
+
+SortKeys::CompareFunc SortKeys::get_compare_func(FileItemModelRole role, bool descending) noexcept {
+    switch (role) {
+        case Role::FileFlag:
+            return descending ? &compare_key<Role::FileFlag, true> : &compare_key<Role::FileFlag, false>;
+
+        case Role::Name:
+            return descending ? &compare_key<Role::Name, true> : &compare_key<Role::Name, false>;
+
+        case Role::Extension:
+            return descending ? &compare_key<Role::Extension, true> : &compare_key<Role::Extension, false>;
+
+        case Role::CreationTime:
+            return descending ? &compare_key<Role::CreationTime, true> : &compare_key<Role::CreationTime, false>;
+
+        case Role::ModTime:
+            return descending ? &compare_key<Role::ModTime, true> : &compare_key<Role::ModTime, false>;
+
+        case Role::Size:
+            return descending ? &compare_key<Role::Size, true> : &compare_key<Role::Size, false>;
+
+        default:
+            break;
+    }
+    assert(false);
+    return nullptr;
+}
+
+template <FileItemModelRole role, bool descending>
+SortKeys::SortFunc SortKeys::get_sort_func(Tie tie) noexcept {
+    switch (tie) {
+        case Tie::Generic:
+            return &SortKeys::sort<role, descending, Tie::Generic>;
+
+        case Tie::NameAscending:
+            return &SortKeys::sort<role, descending, Tie::NameAscending>;
+
+        case Tie::NameDescending:
+            return &SortKeys::sort<role, descending, Tie::NameDescending>;
+    }
+    assert(false);
+    return nullptr;
+}
+
+SortKeys::SortFunc SortKeys::get_sort_func(FileItemModelRole role, bool descending, Tie tie) noexcept {
+    switch (role) {
+        case Role::Name:
+            return descending ? get_sort_func<Role::Name, true>(tie) : get_sort_func<Role::Name, false>(tie);
+
+        case Role::Extension:
+            return descending ? get_sort_func<Role::Extension, true>(tie) : get_sort_func<Role::Extension, false>(tie);
+
+        case Role::CreationTime:
+            return descending ? get_sort_func<Role::CreationTime, true>(tie) : get_sort_func<Role::CreationTime, false>(tie);
+
+        case Role::ModTime:
+            return descending ? get_sort_func<Role::ModTime, true>(tie) : get_sort_func<Role::ModTime, false>(tie);
+
+        case Role::Size:
+            return descending ? get_sort_func<Role::Size, true>(tie) : get_sort_func<Role::Size, false>(tie);
+
+        default:
+            break;
+    }
+    assert(false);
+    return nullptr;
+}
+
+template <FileItemModelRole role, bool descending>
+SortKeys::MergeFunc SortKeys::get_merge_func(Tie tie) noexcept {
+    switch (tie) {
+        case Tie::Generic:
+            return &SortKeys::merge<role, descending, Tie::Generic>;
+
+        case Tie::NameAscending:
+            return &SortKeys::merge<role, descending, Tie::NameAscending>;
+
+        case Tie::NameDescending:
+            return &SortKeys::merge<role, descending, Tie::NameDescending>;
+    }
+    assert(false);
+    return nullptr;
+}
+
+SortKeys::MergeFunc SortKeys::get_merge_func(FileItemModelRole role, bool descending, Tie tie) noexcept {
+    switch (role) {
+        case Role::Name:
+            return descending ? get_merge_func<Role::Name, true>(tie) : get_merge_func<Role::Name, false>(tie);
+
+        case Role::Extension:
+            return descending ? get_merge_func<Role::Extension, true>(tie) : get_merge_func<Role::Extension, false>(tie);
+
+        case Role::CreationTime:
+            return descending ? get_merge_func<Role::CreationTime, true>(tie) : get_merge_func<Role::CreationTime, false>(tie);
+
+        case Role::ModTime:
+            return descending ? get_merge_func<Role::ModTime, true>(tie) : get_merge_func<Role::ModTime, false>(tie);
+
+        case Role::Size:
+            return descending ? get_merge_func<Role::Size, true>(tie) : get_merge_func<Role::Size, false>(tie);
+
+        default:
+            break;
+    }
+    assert(false);
+    return nullptr;
+}
+
+void SortKeys::sort_in_parallel(Iterator first, Iterator last, SortFunc sort_func, MergeFunc merge_func, const Tail& tail, QThreadPool& pool) const {
+    const int chunk_count = std::max(pool.maxThreadCount(), 1);
+    const auto size = last - first;
+    std::vector<Iterator> bounds;
+    bounds.reserve(chunk_count + 1);
+    for (int i = 0; i <= chunk_count; ++i)
+        bounds.push_back(first + size * i / chunk_count);
+
+    QSemaphore semaphore;
+    for (int i = 0; i < chunk_count; ++i)
+        pool.start([this, &bounds, &tail, &semaphore, sort_func, i]() { (this->*sort_func)(bounds[i], bounds[i + 1], tail); semaphore.release(); });
+
+    semaphore.acquire(chunk_count);
+    for (int step = 1; step < chunk_count; step *= 2) { // note: The adjacent sorted chunks are merged pairwise, the merges of a round are independent
+        int task_count = 0;
+        for (int i = 0; i + step < chunk_count; i += 2 * step) {
+            const Iterator chunk_first = bounds[i];
+            const Iterator chunk_middle = bounds[i + step];
+            const Iterator chunk_last = bounds[std::min(i + 2 * step, chunk_count)];
+            pool.start([this, &tail, &semaphore, merge_func, chunk_first, chunk_middle, chunk_last]() { (this->*merge_func)(chunk_first, chunk_middle, chunk_last, tail); semaphore.release(); });
+            ++task_count;
+        }
+        semaphore.acquire(task_count);
+    }
+}
+
+int SortKeys::compare_if_valid(Flag flag, int left, int right) const noexcept {
+    const bool left_is_valid = _keys[left].flags & flag;
+    const bool right_is_valid = _keys[right].flags & flag;
+    return compare_values(right_is_valid, left_is_valid); // note: The objects with unknown values are placed after the others in the ascending order
+}
+
+void SortKeys::append_segments(const QString& name) {
+    const qsizetype size = name.size();
+    qsizetype i = 0;
+    while (i < size) {
+        const qsizetype first = i;
+        const bool digits = name[i].isDigit();
+        if (digits) {
+            uint64_t number = 0;
+            for (; i < size && name[i].isDigit(); ++i) {
+                const uint64_t digit = name[i].digitValue();
+                constexpr uint64_t max = std::numeric_limits<uint64_t>::max();
+                number = number > (max - digit) / 10 ? max : number * 10 + digit; // note: The longer runs saturate, the whole name orders them
+            }
+            _segments.push_back(Segment{number, -1});
+        } else {
+            for (; i < size && !name[i].isDigit(); ++i);
+            _segments.push_back(Segment{0, to_int(_segment_text_keys.size())});
+            _segment_text_keys.push_back(_collator.sortKey(name.sliced(first, i - first)));
+        }
+    }
+    _segment_offsets.push_back(_segments.size());
+}
+
+int SortKeys::compare_segments(int left, int right) const noexcept {
+    const Segment* left_it = _segments.data() + _segment_offsets[left];
+    const Segment* const left_end = _segments.data() + _segment_offsets[left + 1];
+    const Segment* right_it = _segments.data() + _segment_offsets[right];
+    const Segment* const right_end = _segments.data() + _segment_offsets[right + 1];
+    for (; left_it != left_end && right_it != right_end; ++left_it, ++right_it) {
+        const bool left_is_number = left_it->text_key < 0;
+        const bool right_is_number = right_it->text_key < 0;
+        if (left_is_number != right_is_number)
+            return left_is_number ? -1 : 1; // note: A number precedes a text
+
+        const int result = left_is_number ? compare_values(left_it->number, right_it->number) : _segment_text_keys[left_it->text_key].compare(_segment_text_keys[right_it->text_key]);
+        if (result != 0)
+            return result;
+    }
+    return compare_values(left_it != left_end, right_it != right_end);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <QCollator>
+#include <QCollatorSortKey>
+#include <QThreadPool>
+
+#include "../../Util.h"
+#include "../FileItemModel/Role.h"
+
+class FileSystemObject;
+class SortKeysReference;
+
+namespace Qml {
+    class SortParam;
+
+    class SortKeys {
+    public:
+        constexpr static int parallel_threshold = 50'000;
+
+        explicit SortKeys(bool natural = false);
+
+        void reserve(int size);
+        void append(const FileSystemObject& obj);
+        int size() const noexcept;
+        bool is_natural() const noexcept;
+        std::vector<int> get_order(const std::vector<SortParam>& params, QThreadPool* pool = nullptr) const;
+
+    private:
+        friend class ::SortKeysReference;
+
+        enum Flag : uint8_t {File = 1, CreationTimeValid = 2, ModificationTimeValid = 4, SizeValid = 8, ExtensionValid = 16};
+
+        struct Key {
+            int64_t creation_time;
+            int64_t modification_time;
+            uint64_t size;
+            uint8_t flags;
+        };
+
+        struct Segment {
+            uint64_t number;
+            int text_key; // note: -1 for a digit run
+        };
+
+        enum class Tie {Generic, NameAscending, NameDescending}; // note: The name breaks the ties of the most sort parameters, so the sort functions inline it as the second key
+
+        using CompareFunc = int (*)(const SortKeys& keys, int left, int right) noexcept;
+        using Iterator = std::vector<int>::iterator;
+
+        struct Tail {
+            std::array<CompareFunc, to_int(FileItemModelRole::EnumSize) - to_int(FileItemModelRole::Name)> funcs;
+            size_t size = 0;
+        };
+
+        using SortFunc = void (SortKeys::*)(Iterator first, Iterator last, const Tail& tail) const;
+        using MergeFunc = void (SortKeys::*)(Iterator first, Iterator middle, Iterator last, const Tail& tail) const;
+
+        template <FileItemModelRole role>
+        int compare_ascending(int left, int right) const noexcept;
+        template <FileItemModelRole role, bool descending>
+        static int compare_key(const SortKeys& keys, int left, int right) noexcept;
+        template <FileItemModelRole role, bool descending, Tie tie>
+        bool is_less(int left, int right, const Tail& tail) const noexcept;
+        template <FileItemModelRole role, bool descending, Tie tie>
+        void sort(Iterator first, Iterator last, const Tail& tail) const;
+        template <FileItemModelRole role, bool descending, Tie tie>
+        void merge(Iterator first, Iterator middle, Iterator last, const Tail& tail) const;
+        static CompareFunc get_compare_func(FileItemModelRole role, bool descending) noexcept;
+        template <FileItemModelRole role, bool descending>
+        static SortFunc get_sort_func(Tie tie) noexcept;
+        static SortFunc get_sort_func(FileItemModelRole role, bool descending, Tie tie) noexcept;
+        template <FileItemModelRole role, bool descending>
+        static MergeFunc get_merge_func(Tie tie) noexcept;
+        static MergeFunc get_merge_func(FileItemModelRole role, bool descending, Tie tie) noexcept;
+        void sort_in_parallel(Iterator first, Iterator last, SortFunc sort_func, MergeFunc merge_func, const Tail& tail, QThreadPool& pool) const;
+        int compare_if_valid(Flag flag, int left, int right) const noexcept;
+        void append_segments(const QString& name);
+        int compare_segments(int left, int right) const noexcept;
+
+    private:
+        const QCollator _collator;
+        const QCollatorSortKey _empty_key;
+        std::vector<Key> _keys;
+        std::vector<QCollatorSortKey> _name_keys;
+        std::vector<QCollatorSortKey> _extension_keys;
+        const bool _natural;
+        std::vector<Segment> _segments;
+        std::vector<uint32_t> _segment_offsets;
+        std::vector<QCollatorSortKey> _segment_text_keys;
+    };
+}
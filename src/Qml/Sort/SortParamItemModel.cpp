@@ -47,7 +47,7 @@ QHash<int, QByteArray> SortParamItemModel::roleNames() const {
     return names;
 }
 
-bool SortParamItemModel::hasChanges() const { return _data != _settings->get_sort_params(); }
+bool SortParamItemModel::hasChanges() const { return _data != _settings->get_sort_params() || _natural != _settings->get_natural_sort_flag(); }
 
 void SortParamItemModel::moveUp(int row) {
     assert(row > 0);
@@ -75,10 +75,17 @@ void SortParamItemModel::moveDown(int row) {
     dataChanged(index(row, 0), index(lower, 0), {Qt::DisplayRole, to_int(Role::Descending)});
 }
 
-void SortParamItemModel::save() { _settings->set_sort_params(_data); }
+bool SortParamItemModel::getNaturalFlag() const { return _natural; }
+
+void SortParamItemModel::setNaturalFlag(bool natural) { _natural = natural; }
+
+void SortParamItemModel::save() {
+    _settings->set_sort_params(_data, _natural);
+}
 
 void SortParamItemModel::resetChanges() {
     beginResetModel();
     _data = _settings->get_sort_params();
+    _natural = _settings->get_natural_sort_flag();
     endResetModel();
 }
@@ -34,6 +34,8 @@ namespace Qml {
         Q_INVOKABLE void moveUp(int row);
         Q_INVOKABLE void invert();
         Q_INVOKABLE void moveDown(int row);
+        Q_INVOKABLE bool getNaturalFlag() const;
+        Q_INVOKABLE void setNaturalFlag(bool natural);
         Q_INVOKABLE void save();
 
     private:
@@ -44,5 +46,6 @@ namespace Qml {
 
         std::shared_ptr<SettingsJsonFile> _settings;
         std::vector<SortParam> _data;
+        bool _natural = false;
     };
 }
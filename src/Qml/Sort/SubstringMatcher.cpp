@@ -0,0 +1,123 @@
+#include "SubstringMatcher.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define WEBDAVCLIENT_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define WEBDAVCLIENT_NEON
+#endif
+
+#include "../../Util.h"
+
+using namespace Qml;
+
+void SubstringMatcher::Pool::reserve(size_t row_count, size_t char_count) {
+    _offsets.reserve(row_count + 1);
+    _chars.reserve(char_count + row_count + _padding);
+}
+
+void SubstringMatcher::Pool::append(const QStringView& str) {
+    const auto first = reinterpret_cast<const char16_t*>(str.utf16());
+    _chars.insert(std::end(_chars), first, first + str.size());
+    _chars.push_back(0);
+    _offsets.push_back(_chars.size());
+}
+
+void SubstringMatcher::Pool::finish() {
+    _chars.resize(_chars.size() + _padding, 0);
+    _chars.shrink_to_fit();
+    _offsets.shrink_to_fit();
+}
+
+int SubstringMatcher::Pool::size() const noexcept { return _offsets.size() - 1; }
+
+QStringView SubstringMatcher::Pool::get(int row) const noexcept { return QStringView(_chars.data() + _offsets[row], _chars.data() + _offsets[row + 1] - 1); }
+
+const char16_t* SubstringMatcher::Pool::get_chars() const noexcept { return _chars.data(); }
+
+const uint32_t* SubstringMatcher::Pool::get_offsets() const noexcept { return _offsets.data(); }
+
+SubstringMatcher::SubstringMatcher(const QStringView& text) : _text(text.toString()) { assert(!_text.isEmpty()); }
+
+void SubstringMatcher::find_all(const Pool& pool, std::vector<int>& rows) const {
+    rows.clear();
+    const int size = pool.size();
+    if (size == 0)
+        return;
+
+    const char16_t* const chars = pool.get_chars();
+    const uint32_t* const offsets = pool.get_offsets();
+    const char16_t* const last = chars + offsets[size] - 1;
+    for (const char16_t* first = chars; first < last;) { // note: The whole pool is scanned at once, the text can't match across a separator, because it doesn't contain 0
+        const char16_t* const match = find(first, last);
+        if (match == last)
+            break;
+
+        const uint32_t* const next = std::upper_bound(offsets, offsets + size + 1, to_type<uint32_t>(match - chars));
+        rows.push_back(next - offsets - 1);
+        first = chars + *next;
+    }
+}
+
+void SubstringMatcher::narrow(const Pool& pool, std::vector<int>& rows) const {
+    const char16_t* const chars = pool.get_chars();
+    const uint32_t* const offsets = pool.get_offsets();
+    const auto mismatches = [this, chars, offsets](int row) {
+        const char16_t* const last = chars + offsets[row + 1] - 1;
+        return find(chars + offsets[row], last) == last;
+    };
+    rows.erase(std::remove_if(std::begin(rows), std::end(rows), mismatches), std::end(rows));
+}
+
+const char16_t* SubstringMatcher::find(const char16_t* first, const char16_t* last) const noexcept {
+    const qsizetype size = _text.size();
+    if (last - first < size)
+        return last;
+
+    const auto text = reinterpret_cast<const char16_t*>(_text.utf16());
+    const char16_t* const end = last - size + 1;
+    const auto is_match = [text, size](const char16_t* candidate) { return size < 3 || std::equal(candidate + 1, candidate + size - 1, text + 1); };
+#if defined(WEBDAVCLIENT_SSE2)
+    const __m128i first_ch = _mm_set1_epi16(text[0]);
+    const __m128i last_ch = _mm_set1_epi16(text[size - 1]);
+    for (const char16_t* it = first; it < end; it += 8) { // note: The first and the last characters select the candidates, the loads past the end read the next strings or the pool padding
+        const __m128i first_block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+        const __m128i last_block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it + size - 1));
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi16(first_block, first_ch), _mm_cmpeq_epi16(last_block, last_ch)));
+        for (; mask != 0; mask &= mask - 1, mask &= mask - 1) {
+            const char16_t* const candidate = it + std::countr_zero(mask) / 2;
+            if (candidate >= end)
+                return last;
+
+            if (is_match(candidate))
+                return candidate;
+        }
+    }
+    return last;
+#elif defined(WEBDAVCLIENT_NEON)
+    const uint16x8_t first_ch = vdupq_n_u16(text[0]);
+    const uint16x8_t last_ch = vdupq_n_u16(text[size - 1]);
+    for (const char16_t* it = first; it < end; it += 8) { // note: The first and the last characters select the candidates, the loads past the end read the next strings or the pool padding
+        const uint16x8_t first_block = vld1q_u16(reinterpret_cast<const uint16_t*>(it));
+        const uint16x8_t last_block = vld1q_u16(reinterpret_cast<const uint16_t*>(it + size - 1));
+        const uint8x8_t narrowed = vmovn_u16(vandq_u16(vceqq_u16(first_block, first_ch), vceqq_u16(last_block, last_ch)));
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+        for (; mask != 0; mask &= ~(uint64_t(0xFF) << (std::countr_zero(mask) & ~7))) {
+            const char16_t* const candidate = it + std::countr_zero(mask) / 8;
+            if (candidate >= end)
+                return last;
+
+            if (is_match(candidate))
+                return candidate;
+        }
+    }
+    return last;
+#else
+    for (const char16_t* it = first; it < end; ++it) {
+        if (*it == text[0] && it[size - 1] == text[size - 1] && is_match(it))
+            return it;
+    }
+    return last;
+#endif
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <QString>
+#include <QStringView>
+
+namespace Qml {
+    class SubstringMatcher {
+    public:
+        class Pool {
+        public:
+            void reserve(size_t row_count, size_t char_count);
+            void append(const QStringView& str);
+            void finish();
+            int size() const noexcept;
+            QStringView get(int row) const noexcept;
+            const char16_t* get_chars() const noexcept;
+            const uint32_t* get_offsets() const noexcept;
+
+        private:
+            constexpr static size_t _padding = 8;
+
+            std::vector<char16_t> _chars; // note: The strings are separated by 0 and followed by _padding zeros, so a vector register can be loaded at any string position
+            std::vector<uint32_t> _offsets = {0};
+        };
+
+        explicit SubstringMatcher(const QStringView& text);
+
+        void find_all(const Pool& pool, std::vector<int>& rows) const;
+        void narrow(const Pool& pool, std::vector<int>& rows) const;
+
+    private:
+        const char16_t* find(const char16_t* first, const char16_t* last) const noexcept;
+
+    private:
+        const QString _text;
+    };
+}
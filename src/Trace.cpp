@@ -0,0 +1,106 @@
+#include "Trace.h"
+
+#include <chrono>
+
+#include "Logger.h"
+#include "Metrics.h"
+#include "Util.h"
+
+std::atomic<bool> Trace::_enabled = false;
+std::atomic<uint64_t> Trace::_dropped_count = 0;
+
+Trace::Span::Span(const char* name) noexcept : _name(name), _start(Trace::start()) {}
+
+Trace::Span::~Span() { Trace::finish(_name, _start); }
+
+bool Trace::is_enabled() noexcept { return _enabled.load(std::memory_order::relaxed); }
+
+void Trace::set_enabled(bool enabled) {
+    if (enabled && !is_enabled()) {
+        Registry& registry = get_registry();
+        const std::lock_guard<std::mutex> locker(registry.mutex);
+        for (const std::shared_ptr<Buffer>& buffer : registry.buffers) { // note: A new trace starts from scratch
+            const std::lock_guard<std::mutex> buffer_locker(buffer->mutex);
+            buffer->events.clear();
+        }
+        _dropped_count.store(0, std::memory_order::relaxed);
+    }
+    _enabled.store(enabled, std::memory_order::relaxed);
+    Logger::log(QtInfoMsg, QT_TR_NOOP("The tracing has been %1"), enabled ? "enabled" : "disabled");
+}
+
+int64_t Trace::start() noexcept { return is_enabled() ? now() : -1; }
+
+void Trace::finish(const char* name, int64_t start) {
+    if (start >= 0)
+        add(name, start, now() - start);
+}
+
+void Trace::add(const char* name, int64_t start, int64_t duration) {
+    if (!is_enabled())
+        return;
+
+    Buffer& buffer = get_buffer();
+    const std::lock_guard<std::mutex> locker(buffer.mutex);
+    if (buffer.events.size() == _max_event_count) {
+        _dropped_count.fetch_add(1, std::memory_order::relaxed);
+        return;
+    }
+    buffer.events.push_back(Event{name, start, duration});
+}
+
+QByteArray Trace::to_json() {
+    QByteArray json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    Registry& registry = get_registry();
+    const std::lock_guard<std::mutex> locker(registry.mutex);
+    for (const std::shared_ptr<Buffer>& buffer : registry.buffers) {
+        const std::lock_guard<std::mutex> buffer_locker(buffer->mutex);
+        for (const Event& event : buffer->events) {
+            if (!first)
+                json += ',';
+
+            first = false;
+            json += "\n{\"name\":\"";
+            json += event.name; // note: The names are literals without quotes and backslashes
+            json += "\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+            json += QByteArray::number(buffer->thread_id);
+            json += ",\"ts\":";
+            json += QByteArray::number(event.start);
+            json += ",\"dur\":";
+            json += QByteArray::number(event.duration);
+            json += '}';
+        }
+    }
+    json += "\n]}\n";
+    const uint64_t dropped_count = _dropped_count.load(std::memory_order::relaxed);
+    static Metrics::Gauge& gauge = Metrics::get_instance()->get_gauge(QStringLiteral("trace.dropped_spans"));
+    gauge.set(dropped_count);
+    if (dropped_count != 0)
+        Logger::log(QtWarningMsg, QT_TR_NOOP("%1 trace spans were dropped, because the trace buffer was full"), dropped_count);
+
+    return json;
+}
+
+int64_t Trace::now() noexcept {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+Trace::Buffer& Trace::get_buffer() {
+    thread_local const std::shared_ptr<Buffer> buffer = []() {
+        auto buffer = std::make_shared<Buffer>();
+        Registry& registry = get_registry();
+        const std::lock_guard<std::mutex> locker(registry.mutex);
+        buffer->thread_id = to_type<int>(registry.buffers.size() + 1);
+        buffer->events.reserve(1024);
+        registry.buffers.push_back(buffer);
+        return buffer;
+    }();
+    return *buffer;
+}
+
+Trace::Registry& Trace::get_registry() {
+    static Registry registry;
+    return registry;
+}
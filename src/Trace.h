@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QByteArray>
+
+// note: The spans are written by every thread into its own buffer, so the threads don't contend with each other. When the tracing is off, a span costs one relaxed load of a flag.
+class Trace {
+public:
+    class Span {
+    public:
+        explicit Span(const char* name) noexcept;
+        ~Span();
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+    private:
+        const char* const _name;
+        const int64_t _start;
+    };
+
+    static bool is_enabled() noexcept;
+    static void set_enabled(bool enabled);
+    static int64_t start() noexcept;
+    static void finish(const char* name, int64_t start);
+    static void add(const char* name, int64_t start, int64_t duration);
+    static QByteArray to_json();
+
+private:
+    struct Event {
+        const char* name; // note: A string literal, so only the pointer is stored
+        int64_t start;
+        int64_t duration;
+    };
+
+    struct Buffer {
+        std::mutex mutex; // note: Only the export locks it besides the owning thread
+        std::vector<Event> events;
+        int thread_id;
+    };
+
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<Buffer>> buffers; // note: The buffers outlive their threads, so the spans of a finished thread are exported too
+    };
+
+    static int64_t now() noexcept;
+    static Buffer& get_buffer();
+    static Registry& get_registry();
+
+private:
+    constexpr static size_t _max_event_count = 1 << 16; // note: Per thread; the later spans are dropped
+
+    static std::atomic<bool> _enabled;
+    static std::atomic<uint64_t> _dropped_count;
+};
@@ -1,5 +1,78 @@
 #include "Util.h"
 
+#include <array>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+QString get_config_path() {
+    QString path = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation);
+#ifndef Q_OS_ANDROID
+    path += "/WebDAVClient_2212ca02-1a86-4707-b731-492959a8fd40";
+#endif
+    return path;
+}
+
+QString get_export_path(const QString& extension) {
+    const QString dir_path = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+    QDir().mkpath(dir_path);
+    return dir_path + QStringLiteral("/web_dav_client_") + QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd_HHmmss")) + extension;
+}
+
 void json_value_exist_warning(const char* key) { qWarning(qUtf8Printable(QObject::tr("The value of the key \"%s\" doesn't exist")), key); }
 
 void json_value_type_warning(const char* key, const QString& value_type) { qWarning(qUtf8Printable(QObject::tr("The value of the key \"%s\" isn't %s")), key, qUtf8Printable(value_type)); }
+
+int64_t get_peak_rss_kib() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? counters.PeakWorkingSetSize / 1024 : -1;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // note: In bytes on Apple platforms, in kilobytes elsewhere
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+QByteArray to_gzip(const QByteArray& data) {
+    const QByteArray zlib = qCompress(data); // note: The 4 bytes of the size, the 2 bytes of the zlib header, the raw deflate stream and the 4 bytes of the Adler-32 checksum
+    QByteArray gzip("\x1F\x8B\x08\x00\x00\x00\x00\x00\x00\xFF", 10);
+    gzip += zlib.mid(6, zlib.size() - 10);
+    const auto append = [&gzip](uint32_t value) {
+        for (int i = 0; i < 4; ++i)
+            gzip += static_cast<char>(value >> (i * 8));
+    };
+    append(get_crc32(data));
+    append(static_cast<uint32_t>(data.size()));
+    return gzip;
+}
+
+uint32_t get_crc32(const QByteArray& data) noexcept {
+    static const auto table = []() {
+        std::array<uint32_t, 256> table;
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; ++bit)
+                value = value & 1 ? 0xEDB88320 ^ (value >> 1) : value >> 1;
+
+            table[i] = value;
+        }
+        return table;
+    }();
+    uint32_t crc = 0xFFFFFFFF;
+    for (const char c : data)
+        crc = table[(crc ^ static_cast<uint8_t>(c)) & 0xFF] ^ (crc >> 8);
+
+    return crc ^ 0xFFFFFFFF;
+}
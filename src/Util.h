@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+
+#include <QByteArray>
 #include <QString>
 
 template <typename T>
@@ -8,5 +11,10 @@ constexpr int to_int(T value) noexcept { return static_cast<int>(value); }
 template <typename T2, typename T1>
 constexpr T2 to_type(T1&& value) noexcept { return static_cast<T2>(value); }
 
+QString get_config_path();
+QString get_export_path(const QString& extension);
 void json_value_exist_warning(const char* key);
 void json_value_type_warning(const char* key, const QString& value_type);
+int64_t get_peak_rss_kib(); // note: -1, if the peak resident set size is unknown
+QByteArray to_gzip(const QByteArray& data);
+uint32_t get_crc32(const QByteArray& data) noexcept;
@@ -1,5 +1,9 @@
+#include <QQmlExtensionPlugin>
+
 #include "App.h"
 
+Q_IMPORT_QML_PLUGIN(WebDavClientPlugin)
+
 int main(int argc, char* argv[]) {
     App app(argc, argv);
     QQmlApplicationEngine engine;
@@ -3,22 +3,30 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <bit>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <ctime>
 #include <deque>
 #include <functional>
 #include <iomanip>
 #include <iterator>
+#include <limits>
 #include <locale>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <sstream>
 #include <stack>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
@@ -28,11 +36,14 @@
 #include <QAbstractListModel>
 #include <QByteArray>
 #include <QChar>
-#include <QClipboard>
-#include <QColor>
+#include <QCollator>
+#include <QCollatorSortKey>
+#include <QCryptographicHash>
+#include <QDate>
+#include <QDateTime>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
-#include <QGuiApplication>
 #include <QHash>
 #include <QIODevice>
 #include <QJsonArray>
@@ -44,19 +55,17 @@
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QObject>
-#include <QPixmap>
-#include <QQmlApplicationEngine>
-#include <QQmlContext>
-#include <QQmlEngine>
-#include <QQuickImageProvider>
 #include <QRegularExpression>
+#include <QSaveFile>
 #include <QScopedPointer>
+#include <QSemaphore>
 #include <QSize>
 #include <QStandardPaths>
 #include <QString>
 #include <QStringList>
 #include <QStringLiteral>
 #include <QTextStream>
+#include <QThreadPool>
 #include <QTimer>
 #include <QUrl>
 #include <QVariant>
@@ -65,3 +74,20 @@
 #include <QtGlobal>
 #include <QtLogging>
 #include <QtSystemDetection>
+
+#ifdef QT_GUI_LIB // note: Qt defines the macros for the linked modules, so the command-line driver and the mock server, which link only Qt Core and Qt Network, share the header
+#include <QClipboard>
+#include <QColor>
+#include <QGuiApplication>
+#include <QPixmap>
+#endif
+
+#ifdef QT_QML_LIB
+#include <QQmlApplicationEngine>
+#include <QQmlContext>
+#include <QQmlEngine>
+#endif
+
+#ifdef QT_QUICK_LIB
+#include <QQuickImageProvider>
+#endif
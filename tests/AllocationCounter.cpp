@@ -0,0 +1,123 @@
+#include "AllocationCounter.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace {
+    struct Counts {
+        uint64_t count = 0;
+        uint64_t size = 0;
+        int64_t live_size = 0; // note: A block freed by another thread, than it was allocated by, moves the live sizes of both threads
+        int64_t peak_size = 0;
+    };
+
+    thread_local Counts counts; // note: It is constant-initialized and trivially destructible, so an access neither allocates nor needs a guard
+
+    void count_allocation(size_t size) noexcept {
+        ++counts.count;
+        counts.size += size;
+        counts.live_size += size;
+        if (counts.peak_size < counts.live_size)
+            counts.peak_size = counts.live_size;
+    }
+
+    void count_deallocation(size_t size) noexcept { counts.live_size -= size; }
+}
+
+#ifdef __GLIBC__
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+    void __libc_free(void* ptr);
+
+    void* malloc(size_t size) noexcept {
+        void* const ptr = __libc_malloc(size);
+        if (ptr)
+            count_allocation(malloc_usable_size(ptr));
+
+        return ptr;
+    }
+
+    void* calloc(size_t count, size_t size) noexcept {
+        void* const ptr = __libc_calloc(count, size);
+        if (ptr)
+            count_allocation(malloc_usable_size(ptr));
+
+        return ptr;
+    }
+
+    void* realloc(void* ptr, size_t size) noexcept {
+        const size_t old_size = ptr ? malloc_usable_size(ptr) : 0;
+        void* const new_ptr = __libc_realloc(ptr, size);
+        if (new_ptr || size == 0) {
+            count_deallocation(old_size);
+            if (new_ptr)
+                count_allocation(malloc_usable_size(new_ptr));
+        }
+        return new_ptr;
+    }
+
+    void free(void* ptr) noexcept {
+        if (ptr)
+            count_deallocation(malloc_usable_size(ptr));
+
+        __libc_free(ptr);
+    }
+}
+#else
+void* operator new(size_t size) {
+    void* const ptr = std::malloc(size == 0 ? 1 : size);
+    if (!ptr)
+        throw std::bad_alloc();
+
+    count_allocation(size);
+    return ptr;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    void* const ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr)
+        count_allocation(size);
+
+    return ptr;
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); } // note: The size is unknown, so the live size isn't decreased
+
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t size) noexcept {
+    if (ptr)
+        count_deallocation(size);
+
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t size) noexcept { operator delete(ptr, size); }
+#endif
+
+AllocationCounter::AllocationCounter() noexcept : _count(counts.count), _size(counts.size), _live_size(counts.live_size) { counts.peak_size = counts.live_size; }
+
+uint64_t AllocationCounter::get_count() const noexcept { return counts.count - _count; }
+
+uint64_t AllocationCounter::get_size() const noexcept { return counts.size - _size; }
+
+int64_t AllocationCounter::get_peak_size() const noexcept { return counts.peak_size - _live_size; }
+
+bool AllocationCounter::counts_malloc() noexcept {
+#ifdef __GLIBC__
+    return true;
+#else
+    return false;
+#endif
+}
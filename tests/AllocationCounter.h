@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+// note: Counts the heap allocations of the current thread since the construction, so the allocations of the other threads don't disturb a measurement.
+//       With glibc the C allocation functions are interposed, so the buffers of QString, QByteArray and the other Qt containers, which Qt allocates with malloc(), are counted together with operator new.
+//       Elsewhere only operator new is counted, so the numbers are the lower bounds. Only one counter may be alive per thread, because the peak size is shared.
+class AllocationCounter {
+public:
+    AllocationCounter() noexcept;
+
+    AllocationCounter(const AllocationCounter&) = delete;
+    AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+    uint64_t get_count() const noexcept;
+    uint64_t get_size() const noexcept;
+    int64_t get_peak_size() const noexcept; // note: The peak of the allocated and not yet freed bytes above the level at the construction
+    static bool counts_malloc() noexcept;
+
+private:
+    const uint64_t _count;
+    const uint64_t _size;
+    const int64_t _live_size;
+};
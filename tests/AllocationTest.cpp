@@ -0,0 +1,170 @@
+#include "AllocationTest.h"
+
+#include <numeric>
+#include <vector>
+
+#include <QDir>
+#include <QStandardPaths>
+#include <QTest>
+
+#include "../src/FileSystem/FileSystemModel.h"
+#include "../src/FileSystem/FileSystemObject.h"
+#include "../src/FileSystem/Parser/Parser.h"
+#include "../src/Logger.h"
+#include "../src/Qml/FileItemModel/FileItemModel.h"
+#include "../src/Qml/FileItemModel/Role.h"
+#include "../src/Qml/Sort/ColumnIndex.h"
+#include "../src/Qml/Sort/FuzzyMatcher.h"
+#include "../src/Qml/Sort/SubstringMatcher.h"
+#include "../src/Util.h"
+#include "AllocationCounter.h"
+#include "MockDavServer/MockDavServer.h"
+
+using namespace Qml;
+
+namespace {
+    using Role = FileItemModelRole;
+
+    constexpr int response_count = 1000;
+    constexpr double max_allocations_per_response = 64; // note: The element names, the text parts, the decoded href, the name and the dates of a response
+    constexpr uint64_t max_allocations_per_substring_pass = 0;
+    constexpr uint64_t max_allocations_per_fuzzy_pass = 0;
+    constexpr uint64_t max_allocations_per_column_pass = 2; // note: The result and the intermediate bitmaps
+
+    QByteArray generate_reply() {
+        QByteArray reply = "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<d:multistatus xmlns:d=\"DAV:\">";
+        reply += "<d:response><d:href>/dav/</d:href><d:propstat><d:prop><d:resourcetype><d:collection/></d:resourcetype></d:prop><d:status>HTTP/1.1 200 OK</d:status></d:propstat></d:response>";
+        for (int i = 1; i < response_count; ++i) {
+            reply += "<d:response><d:href>/dav/Report%20" + QByteArray::number(i) + ".pdf</d:href><d:propstat><d:prop>";
+            reply += "<d:getlastmodified>Mon, 06 Mar 2023 13:49:01 GMT</d:getlastmodified><d:creationdate>2023-03-06T13:49:01Z</d:creationdate>";
+            reply += "<d:getcontentlength>" + QByteArray::number(i * 1000) + "</d:getcontentlength><d:resourcetype/>";
+            reply += "</d:prop><d:status>HTTP/1.1 200 OK</d:status></d:propstat></d:response>";
+        }
+        reply += "</d:multistatus>";
+        return reply;
+    }
+}
+
+AllocationTest::AllocationTest() = default;
+
+AllocationTest::~AllocationTest() = default;
+
+void AllocationTest::initTestCase() {
+    if (!AllocationCounter::counts_malloc())
+        qWarning("Only operator new is counted, so the allocations of the Qt containers are missing from the budgets");
+
+    QStandardPaths::setTestModeEnabled(true);
+    Logger::get_instance()->set_max_level(QtWarningMsg); // note: The debug messages aren't on the measured paths in the release builds either
+    MockDavServer::Config config;
+    config.depth = 0;
+    config.file_count = 200;
+    _server = std::make_unique<MockDavServer>(config);
+    QVERIFY(_server->listen());
+
+    _fs_model = std::make_shared<FileSystemModel>();
+    bool updated = false;
+    _fs_model->add_notification_func(this, [&updated]() { updated = true; });
+    _fs_model->set_server_info(QStringLiteral("127.0.0.1"), _server->get_port());
+    _fs_model->set_root_path(QStringLiteral("/dav/"));
+    _fs_model->request_abs_file_list(QStringLiteral("/dav/"));
+    QTRY_VERIFY_WITH_TIMEOUT(updated, 10'000);
+    _fs_model->remove_notification_func(this);
+    QCOMPARE(_fs_model->size(), size_t(config.file_count));
+}
+
+void AllocationTest::cleanupTestCase() {
+    _fs_model.reset();
+    _server.reset();
+    QDir(get_config_path() + QStringLiteral("/index")).removeRecursively();
+}
+
+void AllocationTest::parsePropfindReply() {
+    const QByteArray reply = generate_reply();
+    Parser::parse_propfind_reply(QStringLiteral("/dav/"), reply); // note: The first parse fills the static tables and the caches
+    const AllocationCounter counter;
+    const Parser::Result result = Parser::parse_propfind_reply(QStringLiteral("/dav/"), reply);
+    const double allocations_per_response = static_cast<double>(counter.get_count()) / response_count;
+    QCOMPARE(result.second.size(), size_t(response_count - 1));
+    QVERIFY2(allocations_per_response <= max_allocations_per_response, qPrintable(QStringLiteral("%1 allocations per response").arg(allocations_per_response)));
+}
+
+void AllocationTest::filter() {
+    using Status = FileSystemObject::Status;
+
+    std::vector<FileSystemObject> objects;
+    for (int i = 0; i < 10'000; ++i) {
+        const auto time = std::make_pair(Status::Ok, std::chrono::sys_seconds(std::chrono::seconds(1'600'000'000 + i)));
+        objects.emplace_back(QStringLiteral("Report_%1.%2").arg(i).arg(i % 3 == 0 ? QStringLiteral("pdf") : QStringLiteral("txt")), FileSystemObject::Type::File, time, time, std::make_pair(Status::Ok, uint64_t(i)));
+    }
+    SubstringMatcher::Pool pool;
+    ColumnIndex index;
+    for (int row = 0; row < int(objects.size()); ++row) {
+        pool.append(objects[row].get_name().toCaseFolded());
+        index.append(row, objects[row]);
+    }
+    pool.finish();
+    index.finish(int(objects.size()));
+    std::vector<int> rows;
+    rows.reserve(objects.size());
+
+    const SubstringMatcher substring_matcher(QStringLiteral("rt_1"));
+    {
+        const AllocationCounter counter;
+        substring_matcher.find_all(pool, rows);
+        rows.resize(objects.size());
+        std::iota(std::begin(rows), std::end(rows), 0);
+        substring_matcher.narrow(pool, rows);
+        QVERIFY2(counter.get_count() <= max_allocations_per_substring_pass, qPrintable(QStringLiteral("%1 allocations").arg(counter.get_count())));
+    }
+    const FuzzyMatcher fuzzy_matcher(QStringLiteral("rp1"));
+    {
+        const AllocationCounter counter;
+        int score = 0;
+        for (int row = 0; row < pool.size(); ++row)
+            score += fuzzy_matcher.score(pool.get(row), objects[row].get_name());
+
+        QVERIFY(score > 0);
+        QVERIFY2(counter.get_count() <= max_allocations_per_fuzzy_pass, qPrintable(QStringLiteral("%1 allocations").arg(counter.get_count())));
+    }
+    ColumnIndex::Filter filter;
+    filter.extensions = {QStringLiteral("pdf")};
+    filter.size = {100, 5000};
+    filter.modification_time.min = 1'600'000'200;
+    {
+        const AllocationCounter counter;
+        ColumnIndex::get_rows(index.select(filter), rows);
+        QVERIFY(!rows.empty());
+        QVERIFY2(counter.get_count() <= max_allocations_per_column_pass, qPrintable(QStringLiteral("%1 allocations").arg(counter.get_count())));
+    }
+}
+
+void AllocationTest::itemData_data() {
+    QTest::addColumn<int>("role");
+    QTest::addColumn<int>("budget"); // note: Per call
+
+    QTest::newRow("name") << to_int(Role::Name) << 0;
+    QTest::newRow("extension") << to_int(Role::Extension) << 2; // note: The extension is cut from the name and lowered
+    QTest::newRow("icon name") << to_int(Role::IconName) << 2;
+    QTest::newRow("wide image width flag") << to_int(Role::WideImageWidthFlag) << 2;
+    QTest::newRow("creation time") << to_int(Role::CreationTime) << 0;
+    QTest::newRow("modification time") << to_int(Role::ModTime) << 0;
+    QTest::newRow("file flag") << to_int(Role::FileFlag) << 0;
+    QTest::newRow("is exit") << to_int(Role::IsExit) << 0;
+    QTest::newRow("size") << to_int(Role::Size) << 0;
+}
+
+void AllocationTest::itemData() {
+    QFETCH(int, role);
+    QFETCH(int, budget);
+
+    const FileItemModel model(_fs_model);
+    const int row_count = model.rowCount();
+    QVERIFY(row_count > 0);
+    const AllocationCounter counter;
+    for (int row = 0; row < row_count; ++row) {
+        const QVariant value = model.data(model.index(row), role);
+        Q_UNUSED(value);
+    }
+    const double allocations_per_call = static_cast<double>(counter.get_count()) / row_count;
+    QVERIFY2(allocations_per_call <= budget, qPrintable(QStringLiteral("%1 allocations per call").arg(allocations_per_call)));
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+
+#include <QObject>
+
+class FileSystemModel;
+class MockDavServer;
+
+// note: The budgets are the upper bounds of the allocations on the hot paths, so a regression fails here instead of showing up as a vague slowdown
+class AllocationTest : public QObject {
+    Q_OBJECT
+
+public:
+    AllocationTest();
+    ~AllocationTest() override;
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void parsePropfindReply();
+    void filter();
+    void itemData_data();
+    void itemData();
+
+private:
+    std::unique_ptr<MockDavServer> _server;
+    std::shared_ptr<FileSystemModel> _fs_model;
+};
@@ -0,0 +1,43 @@
+#include "FileItemModelTest.h"
+
+#include <cmath>
+
+#include <QImage>
+#include <QTest>
+
+#include "../src/Qml/FileItemModel/FileItemModel.h"
+#include "../src/Qml/FileItemModel/SizeDisplayer.h"
+
+using namespace Qml;
+
+void FileItemModelTest::sizeDisplayer_data() {
+    QTest::addColumn<quint64>("bytes");
+    QTest::addColumn<QString>("prefix");
+
+    QTest::newRow("1023") << quint64(1023) << QObject::tr("B");
+    QTest::newRow("1 Ki") << quint64(1024) << QObject::tr("K");
+    QTest::newRow("1 Mi - 1") << quint64(std::pow(1024, 2) - 1) << QObject::tr("K");
+    QTest::newRow("1 Mi") << quint64(std::pow(1024, 2)) << QObject::tr("M");
+    QTest::newRow("1 Gi - 1") << quint64(std::pow(1024, 3) - 1) << QObject::tr("M");
+    QTest::newRow("1 Gi") << quint64(std::pow(1024, 3)) << QObject::tr("G");
+    QTest::newRow("1 Ti - 1") << quint64(std::pow(1024, 4) - 1) << QObject::tr("G");
+    QTest::newRow("1 Ti") << quint64(std::pow(1024, 4)) << QObject::tr("T");
+    QTest::newRow("1 Pi - 1") << quint64(std::pow(1024, 5) - 1) << QObject::tr("T");
+    QTest::newRow("1 Pi") << quint64(std::pow(1024, 5)) << QObject::tr("P");
+    // note: 1 Ei - 1 isn't checked, because the precision of double type isn't enough; long double isn't supported by Qt
+    QTest::newRow("1 Ei") << quint64(std::pow(1024, 6)) << QObject::tr("E");
+    QTest::newRow("max") << quint64(0xFFFFFFFFFFFFFFFF) << QObject::tr("E");
+}
+
+void FileItemModelTest::sizeDisplayer() {
+    QFETCH(quint64, bytes);
+    QFETCH(QString, prefix);
+
+    const QString str = SizeDisplayer::to_string(bytes);
+    QVERIFY2(str.contains(prefix), qPrintable(str));
+}
+
+void FileItemModelTest::iconsExist() {
+    for (const QString& name : FileItemModel::get_icon_names()) // note: The files are read from the source tree, which the resources of the application are built from
+        QVERIFY2(!QImage(QStringLiteral(ICON_DIR "/") + name).isNull(), qPrintable(name));
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <QObject>
+
+class FileItemModelTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void sizeDisplayer_data();
+    void sizeDisplayer();
+    void iconsExist();
+};
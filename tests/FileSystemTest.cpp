@@ -0,0 +1,105 @@
+#include "FileSystemTest.h"
+
+#include <deque>
+#include <vector>
+
+#include <QDir>
+#include <QStandardPaths>
+#include <QTest>
+
+#include "../src/FileSystem/FileSystemModel.h"
+#include "../src/FileSystem/FileSystemObject.h"
+#include "../src/FileSystem/NameIndex.h"
+#include "../src/Util.h"
+
+namespace {
+    using Status = FileSystemObject::Status;
+    using Type = FileSystemObject::Type;
+
+    FileSystemObject make_obj(const QString& name, Type type) { return FileSystemObject(QString(name), type, {Status::None, {}}, {Status::None, {}}, {Status::None, 0}); }
+
+    void fill(NameIndex& index) {
+        index.update_dir(QStringLiteral("/dav/"), {make_obj("Photos", Type::Directory), make_obj("Report 2023.pdf", Type::File), make_obj("notes.txt", Type::File)});
+        index.update_dir(QStringLiteral("/dav/Photos/"), {make_obj("Holiday", Type::Directory), make_obj("report-draft.odt", Type::File)});
+        index.update_dir(QStringLiteral("/dav/Photos/Holiday/"), {make_obj("IMG_0001.jpg", Type::File)});
+    }
+}
+
+void FileSystemTest::initTestCase() {
+    QStandardPaths::setTestModeEnabled(true); // note: The saved name index goes to a test directory instead of the user's configuration
+    QDir(get_config_path() + QStringLiteral("/index")).removeRecursively();
+}
+
+void FileSystemTest::cleanupTestCase() { QDir(get_config_path() + QStringLiteral("/index")).removeRecursively(); }
+
+void FileSystemTest::handleDoubleDots_data() {
+    QTest::addColumn<QString>("path");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("root") << "/" << "/";
+    QTest::newRow("two levels up") << "/test/test2/../../test3/test4/" << "/test3/test4/";
+    QTest::newRow("repeated") << "/test/../test2/../test3/" << "/test3/";
+    QTest::newRow("dots before a name") << "/test/..g/" << "/test/..g/";
+    QTest::newRow("dots after a name") << "/test/g../" << "/test/g../";
+    QTest::newRow("four dots") << "/test/..../" << "/test/..../";
+}
+
+void FileSystemTest::handleDoubleDots() {
+    QFETCH(QString, path);
+    QFETCH(QString, expected);
+
+    QCOMPARE(FileSystemModel::handle_double_dots(path), expected);
+}
+
+void FileSystemTest::searchNameIndex() {
+    NameIndex index{QString()};
+    fill(index);
+    QCOMPARE(index.size(), size_t(6));
+
+    std::vector<NameIndex::Match> matches = index.search(QStringLiteral("REPORT"), false, 10);
+    QCOMPARE(matches.size(), size_t(2));
+    QCOMPARE(matches[0].path, QStringLiteral("/dav/Report 2023.pdf"));
+    QCOMPARE(matches[1].path, QStringLiteral("/dav/Photos/report-draft.odt"));
+
+    matches = index.search(QStringLiteral("Report"), true, 10);
+    QCOMPARE(matches.size(), size_t(1));
+    QCOMPARE(matches[0].name, QStringLiteral("Report 2023.pdf"));
+
+    matches = index.search(QStringLiteral("ho"), false, 10);
+    QCOMPARE(matches.size(), size_t(1));
+    QCOMPARE(matches[0].path, QStringLiteral("/dav/Photos/Holiday/"));
+    QVERIFY(matches[0].is_dir);
+
+    QCOMPARE(index.search(QStringLiteral("port"), false, 1).size(), size_t(1));
+    QVERIFY(index.search(QStringLiteral("tropic"), false, 10).empty());
+
+    index.update_dir(QStringLiteral("/dav/"), {make_obj("Report 2023.pdf", Type::File)});
+    QCOMPARE(index.size(), size_t(1));
+    QVERIFY(index.search(QStringLiteral("img_"), false, 10).empty());
+}
+
+void FileSystemTest::reloadNameIndex() {
+    const QString id = QStringLiteral("127.0.0.1:8080/dav/");
+    {
+        NameIndex index(id);
+        QCOMPARE(index.size(), size_t(0));
+        fill(index);
+        index.update_dir(QStringLiteral("/dav/"), {make_obj("Report 2023.pdf", Type::File)});
+        QVERIFY(index.save());
+    }
+    NameIndex index(id); // note: The saved image is mapped and searched without a rebuild
+    QCOMPARE(index.size(), size_t(1));
+    std::vector<NameIndex::Match> matches = index.search(QStringLiteral("2023"), false, 10);
+    QCOMPARE(matches.size(), size_t(1));
+    QCOMPARE(matches[0].path, QStringLiteral("/dav/Report 2023.pdf"));
+
+    index.update_dir(QStringLiteral("/dav/Music/"), {make_obj("Track 01.flac", Type::File)});
+    QCOMPARE(index.size(), size_t(2));
+    QCOMPARE(index.search(QStringLiteral("track"), false, 10).size(), size_t(1));
+
+    index.update_dir(QStringLiteral("/dav/"), {make_obj("Music", Type::Directory), make_obj("Report 2024.pdf", Type::File)}); // note: The mapped entries of the directory are outdated, until the image is rebuilt
+    matches = index.search(QStringLiteral("re"), false, 10);
+    QCOMPARE(matches.size(), size_t(1));
+    QCOMPARE(matches[0].path, QStringLiteral("/dav/Report 2024.pdf"));
+    QVERIFY(index.search(QStringLiteral("2023"), false, 10).empty());
+}
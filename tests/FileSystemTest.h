@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QObject>
+
+class FileSystemTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void handleDoubleDots_data();
+    void handleDoubleDots();
+    void searchNameIndex();
+    void reloadNameIndex();
+};
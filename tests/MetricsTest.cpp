@@ -0,0 +1,32 @@
+#include "MetricsTest.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include <QTest>
+
+#include "../src/Metrics.h"
+
+void MetricsTest::histogramBuckets() {
+    using Histogram = Metrics::Histogram;
+    for (uint64_t value = 0; value < 100'000; ++value) {
+        const size_t bucket = Histogram::to_bucket(value);
+        QVERIFY(value <= Histogram::get_upper_bound(bucket));
+        QVERIFY(bucket == 0 || Histogram::get_upper_bound(bucket - 1) < value);
+    }
+    QCOMPARE(Histogram::to_bucket(std::numeric_limits<uint64_t>::max()), Histogram::_bucket_count - 1);
+}
+
+void MetricsTest::histogramSummary() {
+    const auto histogram = std::make_unique<Metrics::Histogram>();
+    for (uint64_t value = 1; value <= 1000; ++value)
+        histogram->record(value);
+
+    const Metrics::Histogram::Summary summary = histogram->get_summary();
+    QCOMPARE(summary.count, uint64_t(1000));
+    QCOMPARE(summary.mean, uint64_t(500));
+    QVERIFY(summary.p50 >= 500 && summary.p50 < 500 + 500 / 32 + 1); // note: A percentile has an error of 1/32 at most
+    QVERIFY(summary.p99 >= 990 && summary.p99 < 990 + 990 / 32 + 1);
+    QCOMPARE(summary.max, uint64_t(1000));
+}
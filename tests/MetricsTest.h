@@ -0,0 +1,11 @@
+#pragma once
+
+#include <QObject>
+
+class MetricsTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void histogramBuckets();
+    void histogramSummary();
+};
@@ -0,0 +1,395 @@
+#include "MockDavServer.h"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+
+#include <QRegularExpression>
+#include <QTimeZone>
+#include <QTimer>
+#include <QUrl>
+
+#include "../../src/Util.h"
+
+namespace {
+    constexpr std::array<const char*, 8> extensions{".txt", ".pdf", ".jpg", ".png", ".mp3", ".zip", ".cpp", ".mkv"};
+
+    QString unescape_xml(QString text) { return text.replace(QStringLiteral("&lt;"), QStringLiteral("<")).replace(QStringLiteral("&gt;"), QStringLiteral(">")).replace(QStringLiteral("&quot;"), QStringLiteral("\""))
+                                                    .replace(QStringLiteral("&apos;"), QStringLiteral("'")).replace(QStringLiteral("&amp;"), QStringLiteral("&")); }
+}
+
+MockDavServer::MockDavServer(const Config& config) : _config(config), _fault_generator(config.seed) {
+    QObject::connect(&_server, &QTcpServer::newConnection, [this]() { accept(); });
+}
+
+bool MockDavServer::listen(const QHostAddress& address, uint16_t port) { return _server.listen(address, port); }
+
+uint16_t MockDavServer::get_port() const { return _server.serverPort(); }
+
+uint64_t MockDavServer::get_request_count() const noexcept { return _request_count; }
+
+void MockDavServer::accept() {
+    while (QTcpSocket* const socket = _server.nextPendingConnection()) {
+        const auto connection = std::make_shared<Connection>(Connection{socket});
+        QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, connection]() { read(connection); });
+        QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+    }
+}
+
+void MockDavServer::read(const std::shared_ptr<Connection>& connection) {
+    if (!connection->socket)
+        return;
+
+    connection->buffer += connection->socket->readAll();
+    Request request;
+    while (!connection->busy && parse_request(connection->buffer, request)) { // note: A pipelined request waits, until the previous response is written
+        ++_request_count;
+        connection->busy = true;
+        switch (draw_fault()) {
+            case Fault::None:
+                send(connection, request, handle(request));
+                break;
+
+            case Fault::Reset:
+                connection->socket->abort();
+                return;
+
+            case Fault::Error:
+                send(connection, request, Response{503, "Service Unavailable", {}, {}});
+                break;
+
+            case Fault::Truncate: {
+                Response response = handle(request);
+                response.body.truncate(response.body.size() / 2); // note: The content length matches the truncated body, so the HTTP reply is complete, but the XML isn't
+                send(connection, request, std::move(response));
+                break;
+            }
+        }
+    }
+}
+
+bool MockDavServer::parse_request(QByteArray& buffer, Request& request) {
+    const qsizetype header_end = buffer.indexOf("\r\n\r\n");
+    if (header_end < 0)
+        return false;
+
+    const QList<QByteArray> lines = buffer.left(header_end).split('\n');
+    const QList<QByteArray> request_line = lines.front().trimmed().split(' ');
+    if (request_line.size() < 2) {
+        buffer.clear();
+        return false;
+    }
+    request.method = request_line[0];
+    request.path = QUrl(QString::fromUtf8(request_line[1])).path();
+    request.headers.clear();
+    for (qsizetype i = 1; i < lines.size(); ++i) {
+        const qsizetype colon = lines[i].indexOf(':');
+        if (colon > 0)
+            request.headers.insert(lines[i].left(colon).trimmed().toLower(), lines[i].mid(colon + 1).trimmed());
+    }
+    const qsizetype body_size = request.headers.value("content-length").toLongLong();
+    const qsizetype request_size = header_end + 4 + body_size;
+    if (buffer.size() < request_size)
+        return false;
+
+    request.body = buffer.mid(header_end + 4, body_size);
+    buffer.remove(0, request_size);
+    return true;
+}
+
+MockDavServer::Response MockDavServer::handle(const Request& request) {
+    const QByteArray& method = request.method;
+    if (method == "OPTIONS")
+        return Response{200, "OK", {{"DAV", "1, 2"}, {"DASL", "<DAV:basicsearch>"}, {"Allow", "OPTIONS, PROPFIND, SEARCH, GET, HEAD, PUT, DELETE, MKCOL, COPY, MOVE, PROPPATCH"}}, {}};
+
+    if (method == "PROPFIND")
+        return handle_propfind(request);
+
+    if (method == "SEARCH")
+        return handle_search(request);
+
+    if (method == "GET" || method == "HEAD")
+        return handle_get(request);
+
+    if (method == "PUT" || method == "MKCOL")
+        return Response{201, "Created", {}, {}};
+
+    if (method == "DELETE" || method == "COPY" || method == "MOVE" || method == "PROPPATCH") {
+        if (!resolve(request.path))
+            return Response{404, "Not Found", {}, {}};
+
+        if (method == "DELETE")
+            return Response{204, "No Content", {}, {}};
+
+        if (method == "PROPPATCH")
+            return Response{207, "Multi-Status", {{"Content-Type", "application/xml; charset=\"utf-8\""}}, "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<D:multistatus xmlns:D=\"DAV:\"/>\n"};
+
+        return Response{201, "Created", {}, {}};
+    }
+    return Response{405, "Method Not Allowed", {}, {}};
+}
+
+MockDavServer::Response MockDavServer::handle_propfind(const Request& request) {
+    const std::optional<Node> node = resolve(request.path);
+    if (!node)
+        return Response{404, "Not Found", {}, {}};
+
+    QByteArray body = "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<D:multistatus xmlns:D=\"DAV:\">\n";
+    body += to_response_xml(*node);
+    if (node->is_dir && request.headers.value("depth") != "0") { // note: The infinite depth is served as 1, as many servers do
+        if (node->indices.size() < static_cast<size_t>(_config.depth)) {
+            for (int i = 0; i < _config.dir_count; ++i)
+                body += to_response_xml(get_child(*node, i, true));
+        }
+        for (int i = 0; i < _config.file_count; ++i)
+            body += to_response_xml(get_child(*node, i, false));
+    }
+    body += "</D:multistatus>\n";
+    return Response{207, "Multi-Status", {{"Content-Type", "application/xml; charset=\"utf-8\""}}, std::move(body)};
+}
+
+MockDavServer::Response MockDavServer::handle_search(const Request& request) {
+    static const QRegularExpression href_regexp(QStringLiteral("<D:href>(.*)</D:href>"));
+    static const QRegularExpression literal_regexp(QStringLiteral("<D:literal>(.*)</D:literal>"));
+    const QString body_text = QString::fromUtf8(request.body);
+    const std::optional<Node> scope = resolve(unescape_xml(href_regexp.match(body_text).captured(1)));
+    if (!scope || !scope->is_dir)
+        return Response{404, "Not Found", {}, {}};
+
+    QString pattern = unescape_xml(literal_regexp.match(body_text).captured(1));
+    if (pattern.startsWith('%'))
+        pattern.remove(0, 1);
+
+    if (pattern.endsWith('%') && !pattern.endsWith(QStringLiteral("\\%")))
+        pattern.chop(1);
+
+    static const QRegularExpression escape_regexp(QStringLiteral("\\\\(.)"));
+    pattern.replace(escape_regexp, QStringLiteral("\\1"));
+    const Qt::CaseSensitivity cs = request.body.contains("caseless=\"no\"") ? Qt::CaseSensitive : Qt::CaseInsensitive;
+
+    QByteArray body = "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<D:multistatus xmlns:D=\"DAV:\">\n";
+    std::deque<Node> queue{*scope};
+    size_t match_count = 0;
+    for (size_t node_count = 0; !queue.empty() && match_count < _max_search_match_count && node_count < _max_search_node_count; ++node_count) {
+        const Node dir = std::move(queue.front());
+        queue.pop_front();
+        const int dir_count = dir.indices.size() < static_cast<size_t>(_config.depth) ? _config.dir_count : 0;
+        for (int i = 0; i < dir_count + _config.file_count && match_count < _max_search_match_count; ++i) {
+            const bool is_dir = i < dir_count;
+            const int index = is_dir ? i : i - dir_count;
+            const Node child = get_child(dir, index, is_dir);
+            if (get_name(dir, index, is_dir).contains(pattern, cs)) {
+                body += to_response_xml(child);
+                ++match_count;
+            }
+            if (is_dir)
+                queue.push_back(child);
+        }
+    }
+    body += "</D:multistatus>\n";
+    return Response{207, "Multi-Status", {{"Content-Type", "application/xml; charset=\"utf-8\""}}, std::move(body)};
+}
+
+MockDavServer::Response MockDavServer::handle_get(const Request& request) {
+    const std::optional<Node> node = resolve(request.path);
+    if (!node)
+        return Response{404, "Not Found", {}, {}};
+
+    if (node->is_dir)
+        return Response{200, "OK", {{"Content-Type", "text/html; charset=utf-8"}}, "<html><body>" + get_path(*node).toUtf8() + "</body></html>\n"};
+
+    QByteArray body(get_size(*node), Qt::Uninitialized);
+    uint64_t value = node->hash;
+    for (qsizetype i = 0; i < body.size(); ++i) {
+        if (i % 8 == 0)
+            value = mix(value);
+
+        body[i] = static_cast<char>(value >> (i % 8 * 8));
+    }
+    return Response{200, "OK", {{"Content-Type", "application/octet-stream"}, {"Last-Modified", get_last_modified(*node)}}, std::move(body)};
+}
+
+void MockDavServer::send(const std::shared_ptr<Connection>& connection, const Request& request, Response&& response) {
+    const bool head = request.method == "HEAD";
+    QByteArray body = std::move(response.body);
+    if (_config.gzip && !head && !body.isEmpty() && request.headers.value("accept-encoding").contains("gzip")) {
+        body = to_gzip(body);
+        response.headers.emplace_back("Content-Encoding", "gzip");
+    }
+    const bool chunked = _config.chunked && !head;
+    const bool close = request.headers.value("connection").toLower() == "close";
+    QByteArray data = "HTTP/1.1 " + QByteArray::number(response.status) + ' ' + response.reason + "\r\n";
+    for (const auto& [name, value] : response.headers)
+        data += name + ": " + value + "\r\n";
+
+    data += chunked ? QByteArray("Transfer-Encoding: chunked\r\n") : "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    if (close)
+        data += "Connection: close\r\n";
+
+    data += "\r\n";
+    if (chunked) {
+        for (qsizetype i = 0; i < body.size(); i += _chunk_size) {
+            const QByteArray chunk = body.mid(i, _chunk_size);
+            data += QByteArray::number(chunk.size(), 16) + "\r\n" + chunk + "\r\n";
+        }
+        data += "0\r\n\r\n";
+    } else if (!head) { // note: The reply to HEAD has the content length of GET, but no body
+        data += body;
+    }
+    if (_config.latency <= 0) {
+        write_slices(connection, std::move(data), close);
+        return;
+    }
+    QTimer::singleShot(_config.latency, connection->socket, [this, connection, data, close]() { write_slices(connection, QByteArray(data), close); });
+}
+
+void MockDavServer::write_slices(const std::shared_ptr<Connection>& connection, QByteArray&& data, bool close) {
+    QTcpSocket* const socket = connection->socket;
+    if (socket == nullptr)
+        return;
+
+    const qsizetype slice_size = _config.bandwidth > 0 ? std::max(qsizetype(1), static_cast<qsizetype>(_config.bandwidth * _slice_interval / 1000)) : data.size();
+    if (data.size() <= slice_size) {
+        socket->write(data);
+        finish(connection, close);
+        return;
+    }
+    socket->write(data.first(slice_size)); // note: The bandwidth is limited by writing a slice per interval
+    QTimer::singleShot(_slice_interval, socket, [this, connection, rest = data.sliced(slice_size), close]() { write_slices(connection, QByteArray(rest), close); });
+}
+
+void MockDavServer::finish(const std::shared_ptr<Connection>& connection, bool close) {
+    connection->busy = false;
+    if (close) {
+        connection->socket->disconnectFromHost();
+        return;
+    }
+    if (!connection->buffer.isEmpty())
+        read(connection);
+}
+
+MockDavServer::Fault MockDavServer::draw_fault() {
+    const auto percent = static_cast<int>(_fault_generator() % 100);
+    if (percent < _config.reset_percent)
+        return Fault::Reset;
+
+    if (percent < _config.reset_percent + _config.error_percent)
+        return Fault::Error;
+
+    if (percent < _config.reset_percent + _config.error_percent + _config.truncate_percent)
+        return Fault::Truncate;
+
+    return Fault::None;
+}
+
+MockDavServer::Node MockDavServer::get_root() const noexcept { return Node{{}, true, mix(_config.seed)}; }
+
+std::optional<MockDavServer::Node> MockDavServer::resolve(const QString& path) const {
+    const QString dir_path = path.endsWith('/') ? path : path + '/';
+    if (!dir_path.startsWith(_config.root))
+        return std::nullopt;
+
+    const QStringList segments = path.mid(_config.root.size()).split('/', Qt::SkipEmptyParts);
+    Node node = get_root();
+    for (const QString& segment : segments) {
+        if (!node.is_dir)
+            return std::nullopt;
+
+        const bool is_dir = segment.startsWith(QStringLiteral("dir"));
+        if (!is_dir && !segment.startsWith(QStringLiteral("file")))
+            return std::nullopt;
+
+        const qsizetype prefix_size = is_dir ? 3 : 4;
+        const qsizetype end = segment.indexOf('_');
+        bool ok = false;
+        const int index = end < 0 ? -1 : segment.mid(prefix_size, end - prefix_size).toInt(&ok);
+        const int count = is_dir ? (node.indices.size() < static_cast<size_t>(_config.depth) ? _config.dir_count : 0) : _config.file_count;
+        if (!ok || index < 0 || index >= count || get_name(node, index, is_dir) != segment)
+            return std::nullopt;
+
+        node = get_child(node, index, is_dir);
+    }
+    return node;
+}
+
+QString MockDavServer::get_name(const Node& parent, int index, bool is_dir) const {
+    const uint64_t hash = get_child(parent, index, is_dir).hash;
+    QString name = (is_dir ? QStringLiteral("dir") : QStringLiteral("file")) + QString::number(index) + '_';
+    for (uint64_t value = hash; name.size() < _config.name_length; value = mix(value))
+        name += QChar('a' + value % 26);
+
+    if (!is_dir)
+        name += QLatin1StringView(extensions[hash % extensions.size()]);
+
+    return name;
+}
+
+MockDavServer::Node MockDavServer::get_child(const Node& parent, int index, bool is_dir) const {
+    Node child{parent.indices, is_dir, mix(parent.hash ^ (static_cast<uint64_t>(index) << 1 | (is_dir ? 1 : 0)))};
+    child.indices.push_back(index);
+    return child;
+}
+
+QString MockDavServer::get_path(const Node& node) const {
+    QString path = _config.root;
+    Node dir = get_root();
+    for (size_t i = 0; i < node.indices.size(); ++i) {
+        const bool is_dir = i + 1 < node.indices.size() || node.is_dir;
+        path += get_name(dir, node.indices[i], is_dir);
+        if (is_dir)
+            path += '/';
+
+        dir = get_child(dir, node.indices[i], is_dir);
+    }
+    return path;
+}
+
+int64_t MockDavServer::get_size(const Node& node) const noexcept { return mix(node.hash + 1) % (_config.max_file_size + 1); }
+
+QDateTime MockDavServer::get_modification_time(const Node& node) const {
+    static const QDateTime epoch(QDate(2020, 1, 1), QTime(0, 0), QTimeZone::UTC);
+    return epoch.addSecs(mix(node.hash + 2) % (4 * 365 * 86400));
+}
+
+QByteArray MockDavServer::get_last_modified(const Node& node) const {
+    const QDateTime time = get_modification_time(node);
+    const DateFormat format = _config.date_format == DateFormat::Mixed ? static_cast<DateFormat>(node.hash % 3) : _config.date_format;
+    switch (format) {
+        case DateFormat::Rfc850:
+            return time.toString(QStringLiteral("dddd, dd-MMM-yy hh:mm:ss 'GMT'")).toLatin1();
+
+        case DateFormat::Asctime:
+            return (time.toString(QStringLiteral("ddd MMM ")) + QString::number(time.date().day()).rightJustified(2, ' ') + time.toString(QStringLiteral(" hh:mm:ss yyyy"))).toLatin1();
+
+        default:
+            return time.toString(QStringLiteral("ddd, dd MMM yyyy hh:mm:ss 'GMT'")).toLatin1();
+    }
+}
+
+QByteArray MockDavServer::get_creation_date(const Node& node) const { return get_modification_time(node).addSecs(-static_cast<qint64>(mix(node.hash + 3) % (365 * 86400))).toString(Qt::ISODate).toLatin1(); }
+
+QByteArray MockDavServer::to_response_xml(const Node& node) const {
+    QByteArray xml = "<D:response><D:href>";
+    xml += QUrl::toPercentEncoding(get_path(node), "/");
+    xml += "</D:href><D:propstat><D:prop><D:creationdate>";
+    xml += get_creation_date(node);
+    xml += "</D:creationdate><D:getlastmodified>";
+    xml += get_last_modified(node);
+    xml += "</D:getlastmodified>";
+    if (node.is_dir) {
+        xml += "<D:resourcetype><D:collection/></D:resourcetype>";
+    } else {
+        xml += "<D:resourcetype/><D:getcontentlength>";
+        xml += QByteArray::number(get_size(node));
+        xml += "</D:getcontentlength>";
+    }
+    xml += "</D:prop><D:status>HTTP/1.1 200 OK</D:status></D:propstat></D:response>\n";
+    return xml;
+}
+
+uint64_t MockDavServer::mix(uint64_t value) noexcept { // note: The SplitMix64 finalizer
+    value += 0x9E3779B97F4A7C15;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+    return value ^ (value >> 31);
+}
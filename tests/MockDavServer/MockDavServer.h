@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QHostAddress>
+#include <QPointer>
+#include <QString>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+class MockDavServerTest;
+
+// note: A WebDAV server of a synthetic read-only tree, which is generated from the seed, so every run serves the same names, sizes and dates.
+//       The write methods are acknowledged, but don't change the tree. The faults are drawn from the same seed, so a failing run can be repeated.
+class MockDavServer {
+public:
+    enum class DateFormat {Rfc1123, Rfc850, Asctime, Mixed};
+
+    struct Config {
+        QString root = QStringLiteral("/dav/");
+        int depth = 2;
+        int dir_count = 5; // note: Per directory
+        int file_count = 100; // note: Per directory
+        int name_length = 16;
+        DateFormat date_format = DateFormat::Rfc1123;
+        int64_t max_file_size = 1024 * 1024;
+        int latency = 0; // note: In milliseconds
+        int64_t bandwidth = 0; // note: In bytes per second, 0 means unlimited
+        bool chunked = false;
+        bool gzip = false; // note: Only if the client accepts it
+        int reset_percent = 0;
+        int error_percent = 0;
+        int truncate_percent = 0;
+        uint64_t seed = 1;
+    };
+
+    explicit MockDavServer(const Config& config);
+
+    MockDavServer(const MockDavServer&) = delete;
+    MockDavServer& operator=(const MockDavServer&) = delete;
+
+    bool listen(const QHostAddress& address = QHostAddress::LocalHost, uint16_t port = 0);
+    uint16_t get_port() const;
+    uint64_t get_request_count() const noexcept;
+
+private:
+    friend class MockDavServerTest;
+
+    struct Request {
+        QByteArray method;
+        QString path;
+        QHash<QByteArray, QByteArray> headers; // note: The names are in lower case
+        QByteArray body;
+    };
+
+    struct Response {
+        int status;
+        QByteArray reason;
+        QList<std::pair<QByteArray, QByteArray>> headers;
+        QByteArray body;
+    };
+
+    struct Node {
+        std::vector<int> indices; // note: The child indices from the root; a file index follows the directory ones
+        bool is_dir;
+        uint64_t hash;
+    };
+
+    struct Connection {
+        QPointer<QTcpSocket> socket;
+        QByteArray buffer;
+        bool busy = false;
+    };
+
+    enum class Fault {None, Reset, Error, Truncate};
+
+    void accept();
+    void read(const std::shared_ptr<Connection>& connection);
+    static bool parse_request(QByteArray& buffer, Request& request);
+    Response handle(const Request& request);
+    Response handle_propfind(const Request& request);
+    Response handle_search(const Request& request);
+    Response handle_get(const Request& request);
+    void send(const std::shared_ptr<Connection>& connection, const Request& request, Response&& response);
+    void write_slices(const std::shared_ptr<Connection>& connection, QByteArray&& data, bool close);
+    void finish(const std::shared_ptr<Connection>& connection, bool close);
+    Fault draw_fault();
+
+    Node get_root() const noexcept;
+    std::optional<Node> resolve(const QString& path) const;
+    QString get_name(const Node& parent, int index, bool is_dir) const;
+    Node get_child(const Node& parent, int index, bool is_dir) const;
+    QString get_path(const Node& node) const;
+    int64_t get_size(const Node& node) const noexcept;
+    QDateTime get_modification_time(const Node& node) const;
+    QByteArray get_last_modified(const Node& node) const;
+    QByteArray get_creation_date(const Node& node) const;
+    QByteArray to_response_xml(const Node& node) const;
+
+    static uint64_t mix(uint64_t value) noexcept;
+
+private:
+    constexpr static qsizetype _chunk_size = 8 * 1024;
+    constexpr static int _slice_interval = 20; // note: In milliseconds
+    constexpr static size_t _max_search_match_count = 10'000;
+    constexpr static size_t _max_search_node_count = 1'000'000;
+
+    const Config _config;
+    QTcpServer _server;
+    std::mt19937_64 _fault_generator;
+    uint64_t _request_count = 0;
+};
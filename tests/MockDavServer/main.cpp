@@ -0,0 +1,76 @@
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTextStream>
+
+#include "MockDavServer.h"
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("mock_dav_server"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QObject::tr("Serves a synthetic WebDAV tree for the tests and the benchmarks"));
+    parser.addHelpOption();
+    const QCommandLineOption port_option({QStringLiteral("p"), QStringLiteral("port")}, QObject::tr("The listening port."), QStringLiteral("port"), QStringLiteral("8080"));
+    const QCommandLineOption root_option(QStringLiteral("root"), QObject::tr("The root path of the tree."), QStringLiteral("path"), QStringLiteral("/dav/"));
+    const QCommandLineOption depth_option(QStringLiteral("depth"), QObject::tr("The depth of the tree."), QStringLiteral("depth"), QStringLiteral("2"));
+    const QCommandLineOption dirs_option(QStringLiteral("dirs"), QObject::tr("The number of the subdirectories per directory."), QStringLiteral("count"), QStringLiteral("5"));
+    const QCommandLineOption files_option(QStringLiteral("files"), QObject::tr("The number of the files per directory."), QStringLiteral("count"), QStringLiteral("100"));
+    const QCommandLineOption name_length_option(QStringLiteral("name-length"), QObject::tr("The length of the names without the index and the extension."), QStringLiteral("length"), QStringLiteral("16"));
+    const QCommandLineOption date_format_option(QStringLiteral("date-format"), QObject::tr("The date format: rfc1123, rfc850, asctime or mixed."), QStringLiteral("format"), QStringLiteral("rfc1123"));
+    const QCommandLineOption max_size_option(QStringLiteral("max-size"), QObject::tr("The maximum file size in bytes."), QStringLiteral("bytes"), QStringLiteral("1048576"));
+    const QCommandLineOption latency_option(QStringLiteral("latency"), QObject::tr("The delay of every response in milliseconds."), QStringLiteral("ms"), QStringLiteral("0"));
+    const QCommandLineOption bandwidth_option(QStringLiteral("bandwidth"), QObject::tr("The bandwidth in bytes per second, unlimited by default."), QStringLiteral("bytes"), QStringLiteral("0"));
+    const QCommandLineOption chunked_option(QStringLiteral("chunked"), QObject::tr("Send the bodies in the chunked transfer encoding."));
+    const QCommandLineOption gzip_option(QStringLiteral("gzip"), QObject::tr("Compress the bodies, if the client accepts gzip."));
+    const QCommandLineOption reset_option(QStringLiteral("reset-percent"), QObject::tr("The percentage of the requests, whose connection is reset."), QStringLiteral("percent"), QStringLiteral("0"));
+    const QCommandLineOption error_option(QStringLiteral("error-percent"), QObject::tr("The percentage of the requests, which are answered with 503."), QStringLiteral("percent"), QStringLiteral("0"));
+    const QCommandLineOption truncate_option(QStringLiteral("truncate-percent"), QObject::tr("The percentage of the requests, whose body is truncated."), QStringLiteral("percent"), QStringLiteral("0"));
+    const QCommandLineOption seed_option(QStringLiteral("seed"), QObject::tr("The seed of the tree and the faults."), QStringLiteral("seed"), QStringLiteral("1"));
+    parser.addOptions({port_option, root_option, depth_option, dirs_option, files_option, name_length_option, date_format_option, max_size_option, latency_option, bandwidth_option,
+                       chunked_option, gzip_option, reset_option, error_option, truncate_option, seed_option});
+    parser.process(app);
+
+    MockDavServer::Config config;
+    config.root = parser.value(root_option);
+    if (!config.root.startsWith('/'))
+        config.root.prepend('/');
+
+    if (!config.root.endsWith('/'))
+        config.root.append('/');
+
+    config.depth = parser.value(depth_option).toInt();
+    config.dir_count = parser.value(dirs_option).toInt();
+    config.file_count = parser.value(files_option).toInt();
+    config.name_length = parser.value(name_length_option).toInt();
+    config.max_file_size = parser.value(max_size_option).toLongLong();
+    config.latency = parser.value(latency_option).toInt();
+    config.bandwidth = parser.value(bandwidth_option).toLongLong();
+    config.chunked = parser.isSet(chunked_option);
+    config.gzip = parser.isSet(gzip_option);
+    config.reset_percent = parser.value(reset_option).toInt();
+    config.error_percent = parser.value(error_option).toInt();
+    config.truncate_percent = parser.value(truncate_option).toInt();
+    config.seed = parser.value(seed_option).toULongLong();
+    const QString date_format = parser.value(date_format_option);
+    if (date_format == QStringLiteral("rfc850"))
+        config.date_format = MockDavServer::DateFormat::Rfc850;
+    else if (date_format == QStringLiteral("asctime"))
+        config.date_format = MockDavServer::DateFormat::Asctime;
+    else if (date_format == QStringLiteral("mixed"))
+        config.date_format = MockDavServer::DateFormat::Mixed;
+
+    QTextStream err(stderr);
+    if (config.reset_percent + config.error_percent + config.truncate_percent > 100) {
+        err << QObject::tr("The sum of the fault percentages exceeds 100") << '\n';
+        return 2;
+    }
+    MockDavServer server(config);
+    if (!server.listen(QHostAddress::LocalHost, parser.value(port_option).toUShort())) {
+        err << QObject::tr("Failed to listen on the port %1").arg(parser.value(port_option)) << '\n';
+        return 1;
+    }
+    QTextStream(stdout) << "http://127.0.0.1:" << server.get_port() << config.root << Qt::endl;
+    return app.exec();
+}
@@ -0,0 +1,28 @@
+#include "MockDavServerTest.h"
+
+#include <optional>
+
+#include <QTest>
+
+#include "MockDavServer/MockDavServer.h"
+
+void MockDavServerTest::resolve() {
+    using Node = MockDavServer::Node;
+    MockDavServer::Config config;
+    config.depth = 2;
+    config.dir_count = 3;
+    config.file_count = 4;
+    const MockDavServer server(config);
+    const Node root = server.get_root();
+    const Node dir = server.get_child(root, 2, true);
+    const Node file = server.get_child(dir, 3, false);
+    for (const Node& node : {root, dir, file}) {
+        const std::optional<Node> resolved = server.resolve(server.get_path(node));
+        QVERIFY(resolved);
+        QVERIFY(resolved->indices == node.indices && resolved->is_dir == node.is_dir && resolved->hash == node.hash);
+    }
+    QVERIFY(server.get_path(file).startsWith(QStringLiteral("/dav/dir2_")));
+    QCOMPARE(server.get_name(dir, 3, false).size(), qsizetype(config.name_length + 4)); // note: Every extension has 4 characters
+    QVERIFY(!server.resolve(QStringLiteral("/dav/dir3_abc/")));
+    QVERIFY(!server.resolve(QStringLiteral("/other/")));
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <QObject>
+
+class MockDavServerTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void resolve();
+};
@@ -0,0 +1,199 @@
+#include "ParserTest.h"
+
+#include <chrono>
+
+#include <QDateTime>
+#include <QTest>
+#include <QTimeZone>
+
+#include "../src/FileSystem/FileSystemObject.h"
+#include "../src/FileSystem/Parser/Parser.h"
+#include "../src/FileSystem/Parser/TimeParser.h"
+
+namespace {
+    using TimeParser = Parser::CurrentState::TimeParser;
+
+    QString to_string(std::chrono::sys_seconds seconds) { return QDateTime::fromSecsSinceEpoch(seconds.time_since_epoch().count(), QTimeZone::UTC).toString(Qt::ISODate); }
+}
+
+void ParserTest::toSysSeconds_data() {
+    QTest::addColumn<QString>("input");
+    QTest::addColumn<bool>("rfc3339");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("rfc1123") << "Sun, 06 Nov 1999 08:49:37 GMT" << false << "1999-11-06T08:49:37Z";
+    QTest::newRow("rfc850") << "Sunday, 06-Nov-99 08:49:37 GMT" << false << "1999-11-06T08:49:37Z";
+    QTest::newRow("asctime") << "Sun Nov 6 08:49:37 1999" << false << "1999-11-06T08:49:37Z";
+    QTest::newRow("rfc1123 after 2000") << "Sun, 06 Nov 2024 08:49:37 GMT" << false << "2024-11-06T08:49:37Z";
+    QTest::newRow("rfc3339 utc") << "1985-04-12T23:20:50.52Z" << true << "1985-04-12T23:20:51Z";
+    QTest::newRow("rfc3339 negative offset") << "1996-12-19T16:39:57.473-08:21" << true << "1996-12-20T01:00:57Z";
+    QTest::newRow("rfc3339 positive offset") << "1996-12-19T16:29:57+08:30" << true << "1996-12-19T07:59:57Z";
+}
+
+void ParserTest::toSysSeconds() {
+    QFETCH(QString, input);
+    QFETCH(bool, rfc3339);
+    QFETCH(QString, expected);
+
+    QCOMPARE(to_string(TimeParser::to_sys_seconds(input, rfc3339 ? TimeParser::Format::Rfc3339 : TimeParser::Format::Rfc2616)), expected);
+}
+
+void ParserTest::parsePropfindReply() {
+    const QByteArray reply =
+"<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+"<D:multistatus xmlns:D=\"DAV:\" xmlns:ns0=\"DAV:\">\n"
+    "<D:response xmlns:lp1=\"DAV:\" xmlns:lp2=\"http://apache.org/dav/props/\" xmlns:g0=\"DAV:\">\n"
+        "<D:href>/dav</D:href>\n"
+        "<D:propstat>\n"
+            "<D:prop>\n"
+                "<lp1:resourcetype><D:collection/></lp1:resourcetype>\n"
+            "</D:prop>\n"
+            "<D:status>HTTP/1.1 200 OK</D:status>\n"
+        "</D:propstat>\n"
+        "<D:propstat>\n"
+            "<D:status>HTTP/1.1 403 Forbidden</D:status>\n"
+            "<D:prop>\n"
+                "<lp1:creationdate />\n"
+                "<lp1:getlastmodified />\n"
+            "</D:prop>\n"
+        "</D:propstat>\n"
+        "<D:propstat>\n"
+            "<D:status>HTTP/1.1 404 Not Found</D:status>\n"
+            "<D:prop>\n"
+                "<lp1:getcontentlength/>\n"
+            "</D:prop>\n"
+        "</D:propstat>\n"
+    "</D:response>\n"
+
+    "<D:response xmlns:lp1=\"DAV:\" xmlns:lp2=\"http://apache.org/dav/props/\" xmlns:g0=\"DAV:\">\n"
+        "<D:propstat>\n"
+            "<D:status>HTTP/1.1 404 Not Found</D:status>\n"
+            "<D:prop>\n"
+                "<lp1:getcontentlength/>\n"
+            "</D:prop>\n"
+        "</D:propstat>\n"
+        "<D:propstat>\n"
+            "<D:status>HTTP/1.1 200 OK</D:status>\n"
+            "<D:prop>\n"
+                "<lp1:getlastmodified>Mon, 06 Mar 2023 13:49:01 GMT</lp1:getlastmodified>\n"
+                "<lp1:resourcetype><D:collection/></lp1:resourcetype>\n"
+                "<lp1:creationdate>1996-12-19T16:29:57+08:30</lp1:creationdate>\n"
+            "</D:prop>\n"
+        "</D:propstat>\n"
+        "<D:href>/dav/%d0%94%d0%b8%d1%81%d0%ba%201</D:href>\n" // Диск 1
+    "</D:response>\n"
+
+    "<D:response xmlns:lp1=\"DAV:\" xmlns:lp2=\"http://apache.org/dav/props/\" xmlns:g0=\"DAV:\">\n"
+        "<D:propstat>\n"
+            "<D:prop>\n"
+                "<lp1:creationdate>1996-12-19T16:39:57.473-08:21</lp1:creationdate>\n"
+                "<lp1:getlastmodified>Thu, 09 Mar 2023 06:55:56 GMT</lp1:getlastmodified>\n"
+                "<lp1:resourcetype><D:collection/></lp1:resourcetype>\n"
+            "</D:prop>\n"
+            "<D:status>HTTP/1.1 200 OK</D:status>\n"
+        "</D:propstat>\n"
+        "<D:propstat>\n"
+            "<D:status>HTTP/1.1 404 Not Found</D:status>\n"
+            "<D:prop>\n"
+                "<lp1:getcontentlength/>\n"
+            "</D:prop>\n"
+        "</D:propstat>\n"
+        "<D:href>/dav/%d0%94%d0%b8%d1%81%d0%ba%202/</D:href>\n" // Диск 2
+    "</D:response>\n"
+
+    "<D:response xmlns:lp1=\"DAV:\" xmlns:lp2=\"http://apache.org/dav/props/\" xmlns:g0=\"DAV:\">\n"
+        "<D:propstat>\n"
+            "<D:status>HTTP/1.1 200 OK</D:status>\n"
+            "<D:prop>\n"
+                "<lp1:getlastmodified>Wednesday, 16-Jul-2025 23:59:58 GMT</lp1:getlastmodified>\n"
+            "</D:prop>\n"
+        "</D:propstat>\n"
+        "<D:href>/dav/%d0%94%d0%b8%d1%81%d0%ba%203/</D:href>\n" // Диск 3
+        "<D:propstat>\n"
+            "<D:status>HTTP/1.1 404 Not Found</D:status>\n"
+            "<D:prop>\n"
+                "<lp1:getcontentlength/>\n"
+            "</D:prop>\n"
+        "</D:propstat>\n"
+        "<D:propstat>\n"
+            "<D:prop>\n"
+                "<lp1:resourcetype />\n"
+            "</D:prop>\n"
+            "<D:status>HTTP/1.1 401 Unauthorized</D:status>\n"
+        "</D:propstat>\n"
+    "</D:response>\n"
+
+    "<D:response xmlns:lp1=\"DAV:\" xmlns:lp2=\"http://apache.org/dav/props/\" xmlns:g0=\"DAV:\">\n"
+        "<D:propstat>\n"
+            "<D:prop>\n"
+                "<lp1:getcontentlength>1743607603214300</lp1:getcontentlength>\n"
+                "<lp1:getlastmodified>Wednesday, 16-Jul-2025 23:59:58 GMT</lp1:getlastmodified>\n"
+                "<lp1:resourcetype />\n"
+            "</D:prop>\n"
+            "<D:status>HTTP/1.1 200 OK</D:status>\n"
+        "</D:propstat>\n"
+        "<D:propstat>\n"
+            "<D:status>HTTP/1.1 404 Not Found</D:status>\n"
+            "<D:prop>\n"
+                "<lp1:creationdate />\n"
+            "</D:prop>\n"
+        "</D:propstat>\n"
+        "<D:href>/dav/%D0%A2%D0%B5%D1%81%D1%82%D0%BE%D0%B2%D1%8B%D0%B9%20%D1%84%D0%B0%D0%B9%D0%BB.txt</D:href>\n" // Тестовый файл.txt
+    "</D:response>\n"
+
+    "<D:response xmlns:lp1=\"DAV:\" xmlns:lp2=\"http://apache.org/dav/props/\" xmlns:g0=\"DAV:\">\n"
+        "<D:propstat>\n"
+            "<D:prop>\n"
+                "<lp1:getlastmodified>Wednesday, 16-Jul-2025 23:59:58 GMT</lp1:getlastmodified>\n"
+                "<lp1:resourcetype />\n"
+            "</D:prop>\n"
+            "<D:status>HTTP/1.1 200 OK</D:status>\n"
+        "</D:propstat>\n"
+        "<D:propstat>\n"
+            "<D:status>HTTP/1.1 404 Not Found</D:status>\n"
+            "<D:prop>\n"
+                "<lp1:creationdate />\n"
+            "</D:prop>\n"
+        "</D:propstat>\n"
+        "<D:href></D:href>\n"
+    "</D:response>\n"
+"</D:multistatus>";
+
+    const Parser::Result result = Parser::parse_propfind_reply(QStringLiteral("/dav/"), reply);
+    const FileSystemObject* const obj = result.first.get();
+    QVERIFY(obj);
+    QCOMPARE(obj->get_name(), QStringLiteral("dav"));
+    QCOMPARE(obj->get_type(), FileSystemObject::Type::Directory);
+    QVERIFY(!obj->is_creation_time_valid());
+    QVERIFY(!obj->is_modification_time_valid());
+    QVERIFY(!obj->is_size_valid());
+
+    QCOMPARE(result.second.size(), size_t(3));
+
+    auto it = std::begin(result.second);
+    QCOMPARE(it->get_name(), QStringLiteral("Диск 1"));
+    QCOMPARE(it->get_type(), FileSystemObject::Type::Directory);
+    QVERIFY(it->is_creation_time_valid());
+    QCOMPARE(to_string(it->get_creation_time()), QStringLiteral("1996-12-19T07:59:57Z"));
+    QVERIFY(it->is_modification_time_valid());
+    QCOMPARE(to_string(it->get_modification_time()), QStringLiteral("2023-03-06T13:49:01Z"));
+    QVERIFY(!it->is_size_valid());
+
+    ++it;
+    QCOMPARE(it->get_name(), QStringLiteral("Диск 2"));
+    QCOMPARE(it->get_type(), FileSystemObject::Type::Directory);
+    QVERIFY(it->is_creation_time_valid());
+    QCOMPARE(to_string(it->get_creation_time()), QStringLiteral("1996-12-20T01:00:57Z"));
+    QVERIFY(it->is_modification_time_valid());
+    QCOMPARE(to_string(it->get_modification_time()), QStringLiteral("2023-03-09T06:55:56Z"));
+    QVERIFY(!it->is_size_valid());
+
+    ++it;
+    QCOMPARE(it->get_name(), QStringLiteral("Тестовый файл.txt"));
+    QCOMPARE(it->get_type(), FileSystemObject::Type::File);
+    QVERIFY(!it->is_creation_time_valid());
+    QVERIFY(it->is_modification_time_valid());
+    QCOMPARE(to_string(it->get_modification_time()), QStringLiteral("2025-07-16T23:59:58Z"));
+    QVERIFY(it->is_size_valid());
+    QCOMPARE(it->get_size(), uint64_t(1743607603214300));
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <QObject>
+
+class ParserTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void toSysSeconds_data();
+    void toSysSeconds();
+    void parsePropfindReply();
+};
@@ -0,0 +1,23 @@
+#include "SortKeysReference.h"
+
+using Qml::SortKeys;
+using Qml::SortParam;
+
+int SortKeysReference::compare(const SortKeys& keys, const std::vector<SortParam>& params, int left, int right) noexcept {
+    for (const SortParam& param : params) {
+        const int result = SortKeys::get_compare_func(param.role, param.descending)(keys, left, right);
+        if (result != 0)
+            return result;
+    }
+    return 0;
+}
+
+std::vector<int> SortKeysReference::get_ranks(const SortKeys& keys, const std::vector<SortParam>& params, QThreadPool* pool) {
+    const std::vector<int> order = keys.get_order(params, pool);
+    const int size = order.size();
+    std::vector<int> ranks(size);
+    for (int i = 0; i < size; ++i)
+        ranks[order[i]] = i;
+
+    return ranks;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <vector>
+
+#include <QThreadPool>
+
+#include "../src/Qml/Sort/SortKeys.h"
+#include "../src/Qml/Sort/SortParam.h"
+
+// note: The generic comparator chain over the sort keys, which the tests check the specialised sort of SortKeys against and the comparator benchmark measures it against.
+class SortKeysReference {
+public:
+    static int compare(const Qml::SortKeys& keys, const std::vector<Qml::SortParam>& params, int left, int right) noexcept;
+    static std::vector<int> get_ranks(const Qml::SortKeys& keys, const std::vector<Qml::SortParam>& params, QThreadPool* pool = nullptr);
+};
@@ -0,0 +1,187 @@
+#include "SortTest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include <QTest>
+
+#include "../src/FileSystem/FileSystemObject.h"
+#include "../src/Qml/FileItemModel/Role.h"
+#include "../src/Qml/Sort/ColumnIndex.h"
+#include "../src/Qml/Sort/FuzzyMatcher.h"
+#include "../src/Qml/Sort/Listing.h"
+#include "../src/Qml/Sort/SortKeys.h"
+#include "../src/Qml/Sort/SortParam.h"
+#include "../src/Qml/Sort/SubstringMatcher.h"
+#include "SortKeysReference.h"
+
+using namespace Qml;
+
+namespace {
+    using Role = FileItemModelRole;
+    using Status = FileSystemObject::Status;
+
+    std::pair<Status, std::chrono::sys_seconds> to_time(std::chrono::sys_seconds::rep seconds) { return std::make_pair(Status::Ok, std::chrono::sys_seconds(std::chrono::seconds(seconds))); }
+
+    std::pair<Status, uint64_t> to_size(uint64_t value) { return std::make_pair(Status::Ok, value); }
+
+    const QStringList pool_names{"a", "", "abcabd", "xabd", "0123456789abcdef_tail", "abd", "ab", "bd"};
+}
+
+void SortTest::substringMatcher_data() {
+    QTest::addColumn<QString>("text");
+
+    for (const char* text : {"abd", "a", "d", "ab", "tail", "bda", "abcabd", "_", "ba", "1234567890"})
+        QTest::newRow(text) << text;
+}
+
+void SortTest::substringMatcher() {
+    QFETCH(QString, text);
+
+    SubstringMatcher::Pool pool;
+    for (const QString& name : pool_names)
+        pool.append(name);
+
+    pool.finish();
+    QCOMPARE(pool.size(), int(pool_names.size()));
+    QCOMPARE(pool.get(2), QStringLiteral("abcabd"));
+
+    std::vector<int> expected;
+    for (int row = 0; row < pool.size(); ++row) {
+        if (pool_names[row].contains(text))
+            expected.push_back(row);
+    }
+    const SubstringMatcher matcher(text);
+    std::vector<int> rows;
+    matcher.find_all(pool, rows);
+    QCOMPARE(rows, expected);
+
+    rows.resize(pool.size());
+    std::iota(std::begin(rows), std::end(rows), 0);
+    matcher.narrow(pool, rows);
+    QCOMPARE(rows, expected);
+}
+
+void SortTest::fuzzyMatcher() {
+    const FuzzyMatcher matcher(QStringLiteral("fb"));
+    QVERIFY(matcher.score(QStringLiteral("foo_bar"), QStringLiteral("foo_bar")) > matcher.score(QStringLiteral("afoobar"), QStringLiteral("afoobar")));
+    QVERIFY(matcher.score(QStringLiteral("foobar"), QStringLiteral("FooBar")) > matcher.score(QStringLiteral("foobar"), QStringLiteral("foobar")));
+    QCOMPARE(matcher.score(QStringLiteral("bf"), QStringLiteral("bf")), 0);
+    QCOMPARE(matcher.score(QStringLiteral("f"), QStringLiteral("f")), 0);
+    QVERIFY(matcher.may_match(FuzzyMatcher::get_char_mask(QStringLiteral("foo_bar"))));
+    QVERIFY(!matcher.may_match(FuzzyMatcher::get_char_mask(QStringLiteral("foo_ar"))));
+
+    const FuzzyMatcher report_matcher(QStringLiteral("rep2023"));
+    const int compact = report_matcher.score(QStringLiteral("report 2023.pdf"), QStringLiteral("Report 2023.pdf"));
+    const int scattered = report_matcher.score(QStringLiteral("a rare pet 2 0 2 3"), QStringLiteral("a rare pet 2 0 2 3"));
+    QVERIFY(compact > scattered);
+    QVERIFY(scattered > 0);
+
+    const FuzzyMatcher reordered_matcher(QStringLiteral("2024 rep"));
+    QVERIFY(reordered_matcher.may_match(FuzzyMatcher::get_char_mask(QStringLiteral("report_2024.pdf"))));
+    QVERIFY(reordered_matcher.score(QStringLiteral("report_2024.pdf"), QStringLiteral("Report_2024.pdf")) > 0);
+    QCOMPARE(reordered_matcher.score(QStringLiteral("report_2023.pdf"), QStringLiteral("Report_2023.pdf")), 0);
+    QVERIFY(!reordered_matcher.may_match(FuzzyMatcher::get_char_mask(QStringLiteral("report_2023.pdf"))));
+    QVERIFY(FuzzyMatcher(QStringLiteral("  ")).score(QStringLiteral("a"), QStringLiteral("a")) > 0);
+}
+
+void SortTest::sortKeys() {
+    SortKeys keys;
+    keys.append(FileSystemObject("b.txt", FileSystemObject::Type::File, to_time(3), to_time(1), to_size(10)));
+    keys.append(FileSystemObject("a", FileSystemObject::Type::Directory, to_time(2), std::make_pair(Status::None, std::chrono::sys_seconds()), std::make_pair(Status::None, uint64_t(0))));
+    keys.append(FileSystemObject("c.odt", FileSystemObject::Type::File, to_time(1), to_time(1), to_size(5)));
+    keys.append(FileSystemObject("a.txt", FileSystemObject::Type::File, to_time(1), to_time(2), std::make_pair(Status::Forbidden, uint64_t(0))));
+    keys.append(FileSystemObject("d", FileSystemObject::Type::Directory, to_time(5), to_time(3), std::make_pair(Status::None, uint64_t(0))));
+
+    std::vector<SortParam> params;
+    for (const Role role : {Role::FileFlag, Role::Name, Role::ModTime, Role::CreationTime, Role::Size, Role::Extension})
+        params.push_back(SortParam{role, QString(), false});
+
+    for (int i = 0; i < 64; ++i) { // note: Every rotation of the parameters is checked with every combination of the directions
+        std::vector<SortParam> shifted_params(params);
+        std::rotate(std::begin(shifted_params), std::begin(shifted_params) + i % shifted_params.size(), std::end(shifted_params));
+        for (size_t j = 0; j < shifted_params.size(); ++j)
+            shifted_params[j].descending = (i >> j) & 1;
+
+        const std::vector<int> ranks = SortKeysReference::get_ranks(keys, shifted_params);
+        for (int left = 0; left < keys.size(); ++left) {
+            for (int right = 0; right < keys.size(); ++right) {
+                const int result = SortKeysReference::compare(keys, shifted_params, left, right);
+                QVERIFY((result == 0 && left == right) || (result < 0) == (ranks[left] < ranks[right]));
+            }
+        }
+    }
+    QCOMPARE(SortKeysReference::get_ranks(keys, params), std::vector<int>({3, 0, 4, 2, 1}));
+}
+
+void SortTest::naturalSortKeys() {
+    SortKeys keys(true);
+    for (const char* name : {"v1.10", "backup_10", "v1.9", "backup_2", "backup_02", "10", "9"})
+        keys.append(FileSystemObject(name, FileSystemObject::Type::File, to_time(1), to_time(1), to_size(0)));
+
+    QCOMPARE(SortKeysReference::get_ranks(keys, {SortParam{Role::Name, QString(), false}}), std::vector<int>({6, 4, 5, 3, 2, 1, 0}));
+}
+
+void SortTest::columnIndex() {
+    ColumnIndex index;
+    index.append(0, FileSystemObject("a.txt", FileSystemObject::Type::File, to_time(10), to_time(40), to_size(100)));
+    index.append(1, FileSystemObject("b", FileSystemObject::Type::Directory, to_time(20), to_time(30), std::make_pair(Status::None, uint64_t(0))));
+    index.append(2, FileSystemObject("c.PDF", FileSystemObject::Type::File, to_time(30), to_time(20), to_size(5000)));
+    index.append(3, FileSystemObject("d.txt", FileSystemObject::Type::File, to_time(40), std::make_pair(Status::Forbidden, std::chrono::sys_seconds()), to_size(2000)));
+    for (int row = 4; row < 70; ++row)
+        index.append(row, FileSystemObject("e", FileSystemObject::Type::File, to_time(row), to_time(row), to_size(row)));
+
+    index.finish(70);
+    const auto select = [&index](const ColumnIndex::Filter& filter) {
+        std::vector<int> rows;
+        ColumnIndex::get_rows(index.select(filter), rows);
+        return rows;
+    };
+    ColumnIndex::Filter filter;
+    QVERIFY(!filter.is_active());
+    QCOMPARE(select(filter).size(), size_t(70));
+
+    filter.extensions = {QStringLiteral("pdf"), QStringLiteral("txt")};
+    QCOMPARE(select(filter), std::vector<int>({0, 2, 3}));
+
+    filter.size.min = 1000;
+    QCOMPARE(select(filter), std::vector<int>({2, 3}));
+
+    filter.modification_time.max = 25;
+    QCOMPARE(select(filter), std::vector<int>({2}));
+
+    filter = ColumnIndex::Filter();
+    filter.creation_time = {65, 69};
+    QCOMPARE(select(filter), std::vector<int>({65, 66, 67, 68, 69}));
+    QVERIFY(ColumnIndex::contains(index.select(filter), 69));
+    QVERIFY(!ColumnIndex::contains(index.select(filter), 64));
+}
+
+void SortTest::listing() {
+    const auto objects = std::make_shared<const std::deque<FileSystemObject>>(std::deque<FileSystemObject>{
+        FileSystemObject("a.txt", FileSystemObject::Type::File, to_time(10), to_time(40), to_size(100)),
+        FileSystemObject("B", FileSystemObject::Type::Directory, to_time(20), to_time(30), std::make_pair(Status::None, uint64_t(0)))
+    });
+    const auto curr_dir_object = std::make_shared<const FileSystemObject>("dir", FileSystemObject::Type::Directory, to_time(1), to_time(1), std::make_pair(Status::None, uint64_t(0)));
+    const Listing listing(FileItemModel::Snapshot{objects, curr_dir_object});
+    QCOMPARE(listing.size(), 3);
+    QVERIFY(listing.is_exit(0));
+    QVERIFY(!listing.is_exit(1));
+    QCOMPARE(listing.get_names().get(0).toString(), QStringLiteral(".."));
+    QCOMPARE(listing.get_names().get(2).toString(), QStringLiteral("B"));
+    QCOMPARE(listing.get_folded_names().get(2).toString(), QStringLiteral("b"));
+    ColumnIndex::Filter filter;
+    filter.extensions = {QStringLiteral("txt")};
+    std::vector<int> rows;
+    ColumnIndex::get_rows(listing.get_columns().select(filter), rows);
+    QCOMPARE(rows, std::vector<int>({1}));
+
+    const Listing root_listing(FileItemModel::Snapshot{objects, nullptr});
+    QCOMPARE(root_listing.size(), 2);
+    QVERIFY(!root_listing.is_exit(0));
+    QCOMPARE(root_listing.get_names().get(0).toString(), QStringLiteral("a.txt"));
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <QObject>
+
+class SortTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void substringMatcher_data();
+    void substringMatcher();
+    void fuzzyMatcher();
+    void sortKeys();
+    void naturalSortKeys();
+    void columnIndex();
+    void listing();
+};
@@ -0,0 +1,31 @@
+#include "UtilTest.h"
+
+#include <cstdint>
+
+#include <QTest>
+
+#include "../src/Util.h"
+
+namespace {
+    uint32_t to_uint32(const QByteArray& data, qsizetype pos) {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i)
+            value |= uint32_t(static_cast<uint8_t>(data[pos + i])) << (i * 8);
+
+        return value;
+    }
+}
+
+void UtilTest::crc32() {
+    QCOMPARE(get_crc32("123456789"), uint32_t(0xCBF43926));
+    QCOMPARE(get_crc32(QByteArray()), uint32_t(0));
+}
+
+void UtilTest::gzip() {
+    const QByteArray data = QByteArray("web_dav_client ").repeated(100);
+    const QByteArray gzip = to_gzip(data);
+    QVERIFY(gzip.startsWith(QByteArray("\x1F\x8B\x08", 3)));
+    QVERIFY(gzip.size() < data.size());
+    QCOMPARE(to_uint32(gzip, gzip.size() - 8), get_crc32(data)); // note: The trailer holds the CRC-32 and the size of the uncompressed data in the little-endian order
+    QCOMPARE(to_uint32(gzip, gzip.size() - 4), uint32_t(data.size()));
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <QObject>
+
+class UtilTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void crc32();
+    void gzip();
+};
@@ -0,0 +1,28 @@
+#include <QCoreApplication>
+#include <QTest>
+
+#include "AllocationTest.h"
+#include "FileItemModelTest.h"
+#include "FileSystemTest.h"
+#include "MetricsTest.h"
+#include "MockDavServerTest.h"
+#include "ParserTest.h"
+#include "SortTest.h"
+#include "UtilTest.h"
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    ParserTest parser_test;
+    FileSystemTest file_system_test;
+    SortTest sort_test;
+    FileItemModelTest file_item_model_test;
+    AllocationTest allocation_test;
+    MetricsTest metrics_test;
+    MockDavServerTest mock_dav_server_test;
+    UtilTest util_test;
+    int status = 0;
+    for (QObject* const test : std::initializer_list<QObject*>{&parser_test, &file_system_test, &sort_test, &file_item_model_test, &allocation_test, &metrics_test, &mock_dav_server_test, &util_test})
+        status |= QTest::qExec(test, argc, argv);
+
+    return status;
+}